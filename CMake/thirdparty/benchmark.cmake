@@ -0,0 +1,22 @@
+include_guard(GLOBAL)
+
+include(fetch_content)
+include(thirdparty_common)
+
+set(proj_name benchmark)
+
+fetch_content(
+    ${proj_name}_proj
+    GIT_REPOSITORY https://github.com/google/benchmark.git
+    GIT_TAG 0d98dba29d66e93259db7daa53a9327df767a415
+    GIT_SHALLOW true
+    PREFIX "${thirdparty_prefix}/${proj_name}"
+    SOURCE_DIR "${thirdparty_prefix}/${proj_name}/source"
+    BINARY_DIR "${thirdparty_binary_dir}/${proj_name}/bin")
+
+set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+
+add_subdirectory(${${proj_name}_proj_SOURCE_DIR} ${${proj_name}_proj_BINARY_DIR} EXCLUDE_FROM_ALL)
+
+unset(proj_name)
@@ -0,0 +1,64 @@
+#include <cstdint>
+#include <mutex>
+
+#include <dze/atomic_optional.hpp>
+#include <dze/sentinel.hpp>
+
+#include <benchmark/benchmark.h>
+
+// Threads contend on a single slot, each alternately trying to fill it and to empty it.
+
+namespace {
+
+using value_type = int64_t;
+using optional_type = dze::sentinel<value_type, -1>;
+
+class locked_slot
+{
+public:
+    bool try_emplace(const value_type value)
+    {
+        const std::lock_guard lock{m_mutex};
+        if (m_value)
+            return false;
+
+        m_value = value;
+        return true;
+    }
+
+    optional_type take()
+    {
+        const std::lock_guard lock{m_mutex};
+        optional_type result = m_value;
+        m_value.reset();
+        return result;
+    }
+
+private:
+    std::mutex m_mutex;
+    optional_type m_value;
+};
+
+using atomic_slot = dze::atomic_optional<value_type, optional_type::policy_type>;
+
+template <typename Slot>
+void contention(benchmark::State& state)
+{
+    static Slot slot;
+
+    int64_t taken = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        benchmark::DoNotOptimize(slot.try_emplace(state.thread_index()));
+        if (slot.take())
+            ++taken;
+    }
+
+    state.counters["taken"] = benchmark::Counter(
+        static_cast<double>(taken), benchmark::Counter::kIsRate);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(contention, locked_slot)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(contention, atomic_slot)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,68 @@
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <dze/optional.hpp>
+#include <dze/sentinel.hpp>
+
+#include <benchmark/benchmark.h>
+
+// Calls value() from many distinct call sites, so that the code inlined at each of them
+// decides how much of the instruction cache the loop needs. Built with and without exceptions;
+// the bench-sizes target reports the size of the resulting binaries.
+
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE
+#endif
+
+namespace {
+
+constexpr size_t call_sites = 512;
+
+template <typename Opt>
+std::vector<Opt> make_input()
+{
+    std::vector<Opt> result(call_sites);
+    for (size_t i = 0; i != call_sites; ++i)
+        result[i] = static_cast<int64_t>(i);
+
+    return result;
+}
+
+template <size_t Site, typename Opt>
+BENCH_NOINLINE int64_t call_site(const Opt* const opts)
+{
+    return opts[Site].value() * static_cast<int64_t>(Site + 1) + opts[Site / 2].value();
+}
+
+template <typename Opt, size_t... Sites>
+int64_t call_all(const Opt* const opts, std::index_sequence<Sites...>)
+{
+    return (call_site<Sites>(opts) + ...);
+}
+
+template <typename Opt>
+void value(benchmark::State& state)
+{
+    const auto input = make_input<Opt>();
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const Opt* opts = input.data();
+        benchmark::DoNotOptimize(opts);
+        benchmark::DoNotOptimize(call_all(opts, std::make_index_sequence<call_sites>{}));
+    }
+
+    state.SetItemsProcessed(state.iterations() * call_sites * 2);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(value, std::optional<int64_t>);
+BENCHMARK_TEMPLATE(value, dze::optional<int64_t>);
+BENCHMARK_TEMPLATE(value, dze::sentinel<int64_t, -1>);
@@ -0,0 +1,75 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <dze/optional.hpp>
+#include <dze/sentinel.hpp>
+
+#include <benchmark/benchmark.h>
+
+// Built once per DZE_OPTIONAL_CHECK_LEVEL to compare the cost of checking engagement in
+// operator* after the caller has already checked has_value.
+
+namespace {
+
+template <typename Opt>
+std::vector<Opt> make_input(const size_t size)
+{
+    std::mt19937_64 engine{size};
+    std::bernoulli_distribution engaged{0.9};
+    std::uniform_int_distribution<int64_t> values{0, 1'000'000};
+    std::vector<Opt> result(size);
+    for (auto& opt : result)
+    {
+        if (engaged(engine))
+            opt = values(engine);
+    }
+
+    return result;
+}
+
+template <typename Opt>
+void deref(benchmark::State& state)
+{
+    const auto input = make_input<Opt>(static_cast<size_t>(state.range(0)));
+    for ([[maybe_unused]] auto _ : state)
+    {
+        int64_t sum = 0;
+        for (const auto& opt : input)
+        {
+            if (opt.has_value())
+                sum += *opt * *opt + *opt;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Opt>
+void value(benchmark::State& state)
+{
+    const auto input = make_input<Opt>(static_cast<size_t>(state.range(0)));
+    for ([[maybe_unused]] auto _ : state)
+    {
+        int64_t sum = 0;
+        for (const auto& opt : input)
+        {
+            if (opt.has_value())
+                sum += opt.value() * opt.value() + opt.value();
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(deref, dze::optional<int64_t>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(deref, dze::sentinel<int64_t, -1>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(value, dze::optional<int64_t>)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(value, dze::sentinel<int64_t, -1>)->Range(1 << 10, 1 << 16);
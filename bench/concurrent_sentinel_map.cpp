@@ -0,0 +1,71 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+
+#include <dze/concurrent_sentinel_map.hpp>
+
+#include <benchmark/benchmark.h>
+
+// Threads insert ids into a shared dedup table, most of which are already present once the
+// table has warmed up. The table starts empty for every run, so it also resizes.
+
+namespace {
+
+using key_type = uint64_t;
+using value_type = uint64_t;
+
+constexpr key_type empty_key = static_cast<key_type>(-1);
+constexpr key_type key_count = 1 << 20;
+
+class sharded_map
+{
+public:
+    std::pair<value_type, bool> insert(const key_type key, const value_type value)
+    {
+        auto& s = m_shards[std::hash<key_type>{}(key) * 0x9e3779b97f4a7c15u >> 60];
+        const std::lock_guard lock{s.mutex};
+        const auto [it, inserted] = s.map.try_emplace(key, value);
+        return {it->second, inserted};
+    }
+
+private:
+    struct alignas(64) shard
+    {
+        std::mutex mutex;
+        std::unordered_map<key_type, value_type> map;
+    };
+
+    std::array<shard, 16> m_shards;
+};
+
+using sentinel_map = dze::concurrent_sentinel_map<key_type, value_type, empty_key, empty_key>;
+
+template <typename Map>
+void dedup(benchmark::State& state)
+{
+    static std::unique_ptr<Map> map;
+
+    // The loop starts after every thread has got here.
+    if (state.thread_index() == 0)
+        map = std::make_unique<Map>();
+
+    std::mt19937_64 gen{static_cast<uint64_t>(state.thread_index())};
+    int64_t inserted = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const key_type key = gen() % key_count;
+        inserted += map->insert(key, key).second;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["inserted"] = static_cast<double>(inserted);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(dedup, sharded_map)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(dedup, sentinel_map)->ThreadRange(1, 8)->UseRealTime();
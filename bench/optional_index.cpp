@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <dze/optional_index.hpp>
+#include <dze/optional_reference.hpp>
+
+#include <benchmark/benchmark.h>
+
+// Chase walks a linked list whose nodes are shuffled in memory, so every step is a dependent
+// load. Adjacency sums the neighbours of every node of a random graph, reading the edge lists
+// sequentially and the neighbours at random. Each runs from cache-resident sizes to sizes
+// well beyond the last level cache, where the smaller links of optional_index save memory
+// traffic.
+
+namespace {
+
+constexpr size_t edge_count = 4;
+
+template <typename Node>
+struct reference_links
+{
+    using link = dze::optional_reference<const Node>;
+
+    static link make(const std::vector<Node>& nodes, const uint32_t i) { return nodes[i]; }
+
+    static const Node& get(const std::vector<Node>&, const link l) noexcept
+    {
+        return l.value_unchecked();
+    }
+};
+
+template <typename Node>
+struct index_links
+{
+    using link = dze::optional_index<Node>;
+
+    static link make(const std::vector<Node>&, const uint32_t i) { return link{i}; }
+
+    static const Node& get(const std::vector<Node>& nodes, const link l) noexcept
+    {
+        return l.value_unchecked(nodes);
+    }
+};
+
+template <template <typename> typename Links>
+struct list_node
+{
+    using links = Links<list_node>;
+
+    uint32_t value;
+    typename links::link next;
+};
+
+template <template <typename> typename Links>
+struct graph_node
+{
+    using links = Links<graph_node>;
+
+    uint32_t value;
+    std::array<typename links::link, edge_count> edges;
+};
+
+[[nodiscard]] std::vector<uint32_t> shuffled(const size_t size)
+{
+    std::vector<uint32_t> result(size);
+    std::iota(result.begin(), result.end(), uint32_t{0});
+    std::shuffle(result.begin(), result.end(), std::mt19937{size});
+    return result;
+}
+
+template <template <typename> typename Links>
+void chase(benchmark::State& state)
+{
+    using node = list_node<Links>;
+    using links = typename node::links;
+
+    const auto size = static_cast<size_t>(state.range(0));
+    const std::vector<uint32_t> order = shuffled(size);
+
+    // A single cycle through every node in a random order.
+    std::vector<node> nodes(size);
+    for (size_t i = 0; i != size; ++i)
+    {
+        nodes[order[i]].value = static_cast<uint32_t>(i);
+        nodes[order[i]].next = links::make(nodes, order[(i + 1) % size]);
+    }
+
+    const node* current = &nodes[order[0]];
+    for ([[maybe_unused]] auto _ : state)
+    {
+        current = &links::get(nodes, current->next);
+        benchmark::DoNotOptimize(current);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["bytes"] = static_cast<double>(size * sizeof(node));
+}
+
+template <template <typename> typename Links>
+void adjacency(benchmark::State& state)
+{
+    using node = graph_node<Links>;
+    using links = typename node::links;
+
+    const auto size = static_cast<size_t>(state.range(0));
+    std::mt19937 gen{static_cast<uint32_t>(size)};
+    std::uniform_int_distribution<uint32_t> dist{0, static_cast<uint32_t>(size - 1)};
+
+    std::vector<node> nodes(size);
+    for (size_t i = 0; i != size; ++i)
+    {
+        nodes[i].value = static_cast<uint32_t>(i);
+        for (auto& edge : nodes[i].edges)
+            edge = links::make(nodes, dist(gen));
+    }
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        uint64_t sum = 0;
+        for (const node& n : nodes)
+        {
+            for (const auto& edge : n.edges)
+                sum += links::get(nodes, edge).value;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * size * edge_count));
+    state.counters["bytes"] = static_cast<double>(size * sizeof(node));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(chase, reference_links)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(chase, index_links)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(adjacency, reference_links)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(adjacency, index_links)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
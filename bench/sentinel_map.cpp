@@ -0,0 +1,253 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <dze/sentinel_map.hpp>
+
+#include <benchmark/benchmark.h>
+
+// Compares sentinel_map with std::unordered_map and with a linear probing table that checks
+// one slot at a time and keeps each key next to its value. The benchmark argument is the
+// number of keys, which spans tables from cache resident to well past the last level cache.
+
+namespace {
+
+using key_type = uint64_t;
+using value_type = uint64_t;
+
+constexpr key_type empty_key = static_cast<key_type>(-1);
+
+class linear_probing_map
+{
+public:
+    bool insert(const key_type key, const value_type value)
+    {
+        if ((m_size + 1) * 4 > m_slots.size() * 3)
+            grow();
+
+        const size_t slot = find_slot(key);
+        if (m_slots[slot].first == key)
+            return false;
+
+        m_slots[slot] = {key, value};
+        ++m_size;
+        return true;
+    }
+
+    [[nodiscard]] const value_type* find(const key_type key) const noexcept
+    {
+        if (m_slots.empty())
+            return nullptr;
+
+        const auto& slot = m_slots[find_slot(key)];
+        return slot.first == key ? &slot.second : nullptr;
+    }
+
+    bool erase(const key_type key) noexcept
+    {
+        if (m_slots.empty())
+            return false;
+
+        size_t hole = find_slot(key);
+        if (m_slots[hole].first != key)
+            return false;
+
+        for (size_t i = next(hole); m_slots[i].first != empty_key; i = next(i))
+        {
+            if (((i - home(m_slots[i].first)) & mask()) >= ((i - hole) & mask()))
+            {
+                m_slots[hole] = m_slots[i];
+                hole = i;
+            }
+        }
+
+        m_slots[hole].first = empty_key;
+        --m_size;
+        return true;
+    }
+
+private:
+    [[nodiscard]] size_t mask() const noexcept { return m_slots.size() - 1; }
+
+    [[nodiscard]] size_t next(const size_t slot) const noexcept { return (slot + 1) & mask(); }
+
+    [[nodiscard]] size_t home(const key_type key) const noexcept
+    {
+        return static_cast<size_t>(
+            (std::hash<key_type>{}(key) * 0x9e3779b97f4a7c15u) >> (64 - m_bits));
+    }
+
+    // The slot of key or the free slot that ends its cluster.
+    [[nodiscard]] size_t find_slot(const key_type key) const noexcept
+    {
+        size_t slot = home(key);
+        while (m_slots[slot].first != key && m_slots[slot].first != empty_key)
+            slot = next(slot);
+
+        return slot;
+    }
+
+    void grow()
+    {
+        auto old = std::exchange(
+            m_slots,
+            std::vector<std::pair<key_type, value_type>>(
+                m_slots.empty() ? 16 : m_slots.size() * 2, {empty_key, 0}));
+        m_bits = m_bits == 0 ? 4 : m_bits + 1;
+        for (const auto& entry : old)
+        {
+            if (entry.first != empty_key)
+                m_slots[find_slot(entry.first)] = entry;
+        }
+    }
+
+    std::vector<std::pair<key_type, value_type>> m_slots;
+    unsigned m_bits = 0;
+    size_t m_size = 0;
+};
+
+struct unordered
+{
+    std::unordered_map<key_type, value_type> map;
+
+    bool insert(const key_type key, const value_type value)
+    {
+        return map.try_emplace(key, value).second;
+    }
+
+    [[nodiscard]] const value_type* find(const key_type key) const
+    {
+        const auto it = map.find(key);
+        return it == map.end() ? nullptr : &it->second;
+    }
+
+    bool erase(const key_type key) { return map.erase(key) != 0; }
+};
+
+struct linear_probing
+{
+    linear_probing_map map;
+
+    bool insert(const key_type key, const value_type value) { return map.insert(key, value); }
+
+    [[nodiscard]] const value_type* find(const key_type key) const { return map.find(key); }
+
+    bool erase(const key_type key) { return map.erase(key); }
+};
+
+struct sentinel
+{
+    dze::sentinel_map<key_type, value_type, empty_key> map;
+
+    bool insert(const key_type key, const value_type value)
+    {
+        return map.try_emplace(key, value).second;
+    }
+
+    [[nodiscard]] const value_type* find(const key_type key) const { return map.find(key); }
+
+    bool erase(const key_type key) { return map.erase(key); }
+};
+
+[[nodiscard]] std::vector<key_type> make_keys(const size_t count, const uint32_t seed)
+{
+    std::mt19937_64 gen{seed};
+    std::vector<key_type> result(count);
+    for (auto& key : result)
+    {
+        do
+            key = gen();
+        while (key == empty_key);
+    }
+
+    return result;
+}
+
+template <typename Map>
+void insert(benchmark::State& state)
+{
+    const auto keys = make_keys(static_cast<size_t>(state.range(0)), 1);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        Map m;
+        for (const key_type key : keys)
+            m.insert(key, key);
+
+        benchmark::DoNotOptimize(m);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map>
+void find_hit(benchmark::State& state)
+{
+    auto keys = make_keys(static_cast<size_t>(state.range(0)), 1);
+    Map m;
+    for (const key_type key : keys)
+        m.insert(key, key);
+
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{2});
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const key_type key : keys)
+            benchmark::DoNotOptimize(m.find(key));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map>
+void find_miss(benchmark::State& state)
+{
+    Map m;
+    for (const key_type key : make_keys(static_cast<size_t>(state.range(0)), 1))
+        m.insert(key, key);
+
+    const auto misses = make_keys(static_cast<size_t>(state.range(0)), 3);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const key_type key : misses)
+            benchmark::DoNotOptimize(m.find(key));
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Erases a key and inserts another, which keeps the size constant. Tables with tombstones
+// slow down under this pattern until they rehash.
+template <typename Map>
+void churn(benchmark::State& state)
+{
+    const auto count = static_cast<size_t>(state.range(0));
+    const auto keys = make_keys(count * 2, 1);
+    Map m;
+    for (size_t i = 0; i != count; ++i)
+        m.insert(keys[i], keys[i]);
+
+    size_t oldest = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const size_t newest = (oldest + count) % keys.size();
+        m.erase(keys[oldest]);
+        m.insert(keys[newest], keys[newest]);
+        oldest = (oldest + 1) % keys.size();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+#define DZE_SENTINEL_MAP_BENCHMARK(name)                                                      \
+    BENCHMARK_TEMPLATE(name, unordered)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);         \
+    BENCHMARK_TEMPLATE(name, linear_probing)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);    \
+    BENCHMARK_TEMPLATE(name, sentinel)->RangeMultiplier(16)->Range(1 << 8, 1 << 20)
+
+DZE_SENTINEL_MAP_BENCHMARK(insert);
+DZE_SENTINEL_MAP_BENCHMARK(find_hit);
+DZE_SENTINEL_MAP_BENCHMARK(find_miss);
+DZE_SENTINEL_MAP_BENCHMARK(churn);
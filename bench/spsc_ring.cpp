@@ -0,0 +1,130 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include <dze/sentinel.hpp>
+#include <dze/spsc_ring.hpp>
+
+#include <benchmark/benchmark.h>
+
+// Throughput streams messages from a producer thread to the benchmark thread. Latency bounces
+// a message between two threads through a pair of queues, so each iteration is a round trip.
+
+namespace {
+
+using value_type = int64_t;
+using policy = dze::sentinel<value_type, -1>::policy_type;
+
+// The classic ring whose producer and consumer publish their indices to each other.
+class index_ring
+{
+public:
+    explicit index_ring(const size_t capacity)
+        : m_capacity{capacity}
+        , m_slots{std::make_unique<value_type[]>(capacity)} {}
+
+    bool try_push(const value_type value) noexcept
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == m_capacity)
+            return false;
+
+        m_slots[head % m_capacity] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<value_type> try_pop() noexcept
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+            return std::nullopt;
+
+        const value_type result = m_slots[tail % m_capacity];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return result;
+    }
+
+private:
+    const size_t m_capacity;
+    const std::unique_ptr<value_type[]> m_slots;
+    alignas(64) std::atomic<size_t> m_head{0};
+    alignas(64) std::atomic<size_t> m_tail{0};
+};
+
+using sentinel_ring = dze::spsc_ring<value_type, policy>;
+using padded_sentinel_ring = dze::padded_spsc_ring<value_type, policy>;
+
+constexpr size_t capacity = 1024;
+constexpr value_type batch = 1 << 16;
+
+template <typename Ring>
+void throughput(benchmark::State& state)
+{
+    for ([[maybe_unused]] auto _ : state)
+    {
+        Ring ring{capacity};
+        std::thread producer{[&] {
+            for (value_type i = 0; i != batch;)
+            {
+                if (ring.try_push(i))
+                    ++i;
+            }
+        }};
+
+        value_type sum = 0;
+        for (value_type received = 0; received != batch;)
+        {
+            if (const auto value = ring.try_pop())
+            {
+                sum += *value;
+                ++received;
+            }
+        }
+
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+template <typename Ring>
+void latency(benchmark::State& state)
+{
+    Ring ping{capacity};
+    Ring pong{capacity};
+    std::atomic<bool> done{false};
+    std::thread echo{[&] {
+        while (!done.load(std::memory_order_relaxed))
+        {
+            if (const auto value = ping.try_pop())
+            {
+                while (!pong.try_push(*value)) {}
+            }
+        }
+    }};
+
+    value_type i = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        while (!ping.try_push(i)) {}
+        while (!pong.try_pop()) {}
+        ++i;
+    }
+
+    done = true;
+    echo.join();
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(throughput, index_ring)->UseRealTime();
+BENCHMARK_TEMPLATE(throughput, sentinel_ring)->UseRealTime();
+BENCHMARK_TEMPLATE(throughput, padded_sentinel_ring)->UseRealTime();
+BENCHMARK_TEMPLATE(latency, index_ring)->UseRealTime();
+BENCHMARK_TEMPLATE(latency, sentinel_ring)->UseRealTime();
+BENCHMARK_TEMPLATE(latency, padded_sentinel_ring)->UseRealTime();
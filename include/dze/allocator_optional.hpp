@@ -0,0 +1,327 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#include <type_traits>
+#include <utility>
+
+#include <dze/requires.hpp>
+
+#include "nullopt.hpp"
+#include "optional.hpp"
+
+namespace dze {
+
+namespace details::allocator_ns {
+
+template <typename T, typename Alloc, typename... Args>
+constexpr bool constructible_using_allocator_v =
+    std::uses_allocator_v<T, Alloc>
+        ? std::is_constructible_v<T, std::allocator_arg_t, const Alloc&, Args&&...> ||
+            std::is_constructible_v<T, Args&&..., const Alloc&>
+        : std::is_constructible_v<T, Args&&...>;
+
+// Uses-allocator construction of a prvalue, see [allocator.uses.construction].
+template <typename T, typename Alloc, typename... Args>
+[[nodiscard]] T make_using_allocator(const Alloc& alloc, Args&&... args)
+{
+    if constexpr (!std::uses_allocator_v<T, Alloc>)
+        return T(std::forward<Args>(args)...);
+    else if constexpr (
+        std::is_constructible_v<T, std::allocator_arg_t, const Alloc&, Args&&...>)
+        return T(std::allocator_arg, alloc, std::forward<Args>(args)...);
+    else
+        return T(std::forward<Args>(args)..., alloc);
+}
+
+} // namespace details::allocator_ns
+
+// An optional that constructs its value with uses-allocator construction, so that a value
+// such as a std::pmr::string allocates from the allocator of the optional rather than from
+// the default memory resource. Like allocator-aware containers, it propagates its allocator
+// on copy, move and swap according to std::allocator_traits<Alloc>.
+template <typename T, typename Alloc, typename Policy = details::optional_ns::default_policy>
+class allocator_optional
+{
+    using stored_type = std::remove_const_t<T>;
+    using alloc_traits = std::allocator_traits<Alloc>;
+
+    template <typename... Args>
+    static constexpr bool constructible_v =
+        details::allocator_ns::constructible_using_allocator_v<stored_type, Alloc, Args...>;
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using optional_type = optional<T, Policy>;
+
+    allocator_optional() = default;
+
+    explicit allocator_optional(const Alloc& alloc) noexcept
+        : m_alloc{alloc} {}
+
+    allocator_optional(nullopt_t, const Alloc& alloc = Alloc{}) noexcept
+        : m_alloc{alloc} {}
+
+    template <typename U = T,
+        DZE_REQUIRES(
+            !std::is_same_v<allocator_optional, std::decay_t<U>> &&
+            !std::is_same_v<std::in_place_t, std::decay_t<U>> &&
+            !std::is_same_v<nullopt_t, std::decay_t<U>> &&
+            constructible_v<U&&>)>
+    explicit allocator_optional(U&& value, const Alloc& alloc = Alloc{})
+        : m_alloc{alloc}
+    {
+        emplace(std::forward<U>(value));
+    }
+
+    template <typename... Args,
+        DZE_REQUIRES(constructible_v<Args&&...>)>
+    allocator_optional(
+        std::allocator_arg_t, const Alloc& alloc, std::in_place_t, Args&&... args)
+        : m_alloc{alloc}
+    {
+        emplace(std::forward<Args>(args)...);
+    }
+
+    allocator_optional(const allocator_optional& other)
+        : allocator_optional{
+            std::allocator_arg,
+            alloc_traits::select_on_container_copy_construction(other.m_alloc),
+            other} {}
+
+    allocator_optional(
+        std::allocator_arg_t, const Alloc& alloc, const allocator_optional& other)
+        : m_alloc{alloc}
+    {
+        if (other)
+            emplace(*other);
+    }
+
+    // The value keeps the allocator it was constructed with, which is the one moved here.
+    allocator_optional(allocator_optional&& other)
+        noexcept(std::is_nothrow_move_constructible_v<optional_type>)
+        : m_alloc{std::move(other.m_alloc)}
+        , m_value{std::move(other.m_value)} {}
+
+    allocator_optional(std::allocator_arg_t, const Alloc& alloc, allocator_optional&& other)
+        : m_alloc{alloc}
+    {
+        if (m_alloc == other.m_alloc)
+            m_value = std::move(other.m_value);
+        else if (other)
+            emplace(std::move(*other));
+    }
+
+    allocator_optional& operator=(const allocator_optional& other)
+    {
+        if (this == &other)
+            return *this;
+
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+        {
+            if (m_alloc != other.m_alloc)
+            {
+                reset();
+                m_alloc = other.m_alloc;
+            }
+        }
+
+        if (other)
+            *this = *other;
+        else
+            reset();
+
+        return *this;
+    }
+
+    allocator_optional& operator=(allocator_optional&& other)
+        noexcept(
+            (alloc_traits::propagate_on_container_move_assignment::value ||
+                alloc_traits::is_always_equal::value) &&
+            std::is_nothrow_move_assignable_v<optional_type>)
+    {
+        if (this == &other)
+            return *this;
+
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            reset();
+            m_alloc = std::move(other.m_alloc);
+            m_value = std::move(other.m_value);
+        }
+        else if (alloc_traits::is_always_equal::value || m_alloc == other.m_alloc)
+            m_value = std::move(other.m_value);
+        else if (other)
+            *this = std::move(*other);
+        else
+            reset();
+
+        return *this;
+    }
+
+    allocator_optional& operator=(nullopt_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    // An engaged value is assigned to, which keeps its allocator. Otherwise the value is
+    // constructed with the allocator of this.
+    template <typename U = T,
+        DZE_REQUIRES(
+            !std::is_same_v<allocator_optional, std::decay_t<U>> &&
+            !std::is_same_v<nullopt_t, std::decay_t<U>> &&
+            constructible_v<U&&> &&
+            std::is_assignable_v<T&, U&&>)>
+    allocator_optional& operator=(U&& value)
+    {
+        if (m_value)
+            *m_value = std::forward<U>(value);
+        else
+            emplace(std::forward<U>(value));
+
+        return *this;
+    }
+
+    template <typename... Args,
+        DZE_REQUIRES(constructible_v<Args&&...>)>
+    T& emplace(Args&&... args)
+    {
+        return m_value.emplace_with([&] {
+            return details::allocator_ns::make_using_allocator<stored_type>(
+                m_alloc, std::forward<Args>(args)...);
+        });
+    }
+
+    void reset() noexcept { m_value.reset(); }
+
+    // Disengages this without destroying the value. This is for values whose memory is owned
+    // by an arena, such as a std::pmr::monotonic_buffer_resource, that is about to be released
+    // as a whole, which makes running their destructors redundant.
+    void release() noexcept { details::optional_ns::access::release(m_value); }
+
+    void swap(allocator_optional& other)
+        noexcept(noexcept(std::declval<optional_type&>().swap(std::declval<optional_type&>())))
+    {
+        using std::swap;
+
+        if constexpr (alloc_traits::propagate_on_container_swap::value)
+            swap(m_alloc, other.m_alloc);
+        else
+            assert(m_alloc == other.m_alloc);
+
+        m_value.swap(other.m_value);
+    }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return m_alloc; }
+
+    // The underlying optional, e.g. for comparisons and hashing.
+    [[nodiscard]] const optional_type& get_optional() const noexcept { return m_value; }
+
+    const T* operator->() const { return m_value.operator->(); }
+
+    T* operator->() { return m_value.operator->(); }
+
+    const T& operator*() const& { return *m_value; }
+
+    T& operator*() & { return *m_value; }
+
+    T&& operator*() && { return *std::move(m_value); }
+
+    explicit operator bool() const noexcept { return m_value.has_value(); }
+
+    [[nodiscard]] bool has_value() const noexcept { return m_value.has_value(); }
+
+    [[nodiscard]] T& value() & { return m_value.value(); }
+
+    [[nodiscard]] const T& value() const& { return m_value.value(); }
+
+    [[nodiscard]] T&& value() && { return std::move(m_value).value(); }
+
+    template <typename U>
+    [[nodiscard]] T value_or(U&& default_value) const&
+    {
+        return m_value.value_or(std::forward<U>(default_value));
+    }
+
+private:
+    Alloc m_alloc;
+    optional_type m_value;
+};
+
+template <typename T, typename Alloc, typename Policy>
+[[nodiscard]] bool operator==(
+    const allocator_optional<T, Alloc, Policy>& lhs,
+    const allocator_optional<T, Alloc, Policy>& rhs)
+{
+    return lhs.get_optional() == rhs.get_optional();
+}
+
+template <typename T, typename Alloc, typename Policy>
+[[nodiscard]] bool operator!=(
+    const allocator_optional<T, Alloc, Policy>& lhs,
+    const allocator_optional<T, Alloc, Policy>& rhs)
+{
+    return lhs.get_optional() != rhs.get_optional();
+}
+
+template <typename T, typename Alloc, typename Policy>
+[[nodiscard]] bool operator==(
+    const allocator_optional<T, Alloc, Policy>& lhs, nullopt_t) noexcept
+{
+    return !lhs;
+}
+
+template <typename T, typename Alloc, typename Policy>
+[[nodiscard]] bool operator!=(
+    const allocator_optional<T, Alloc, Policy>& lhs, nullopt_t) noexcept
+{
+    return static_cast<bool>(lhs);
+}
+
+template <typename T, typename Alloc, typename Policy, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() == std::declval<U>()), bool>)>
+[[nodiscard]] bool operator==(const allocator_optional<T, Alloc, Policy>& lhs, const U& rhs)
+{
+    return lhs && *lhs == rhs;
+}
+
+template <typename T, typename Alloc, typename Policy, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() != std::declval<U>()), bool>)>
+[[nodiscard]] bool operator!=(const allocator_optional<T, Alloc, Policy>& lhs, const U& rhs)
+{
+    return !lhs || *lhs != rhs;
+}
+
+template <typename T, typename Alloc, typename Policy>
+void swap(
+    allocator_optional<T, Alloc, Policy>& lhs, allocator_optional<T, Alloc, Policy>& rhs)
+    noexcept(noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+template <typename T, typename Alloc, typename Policy>
+struct hash<allocator_optional<T, Alloc, Policy>>
+{
+    size_t operator()(const allocator_optional<T, Alloc, Policy>& opt) const
+    {
+        return hash<optional<T, Policy>>{}(opt.get_optional());
+    }
+};
+
+#if __has_include(<memory_resource>)
+namespace pmr {
+
+template <typename T, typename Policy = details::optional_ns::default_policy>
+using optional = allocator_optional<T, std::pmr::polymorphic_allocator<std::byte>, Policy>;
+
+} // namespace pmr
+#endif
+
+} // namespace dze
@@ -0,0 +1,366 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#include "details/check.hpp"
+#include "nullopt.hpp"
+#include "optional.hpp"
+
+namespace dze {
+
+namespace details::atomic_optional_ns {
+
+// An atomic word of Size bytes. Up to 8 bytes, this is a std::atomic of an unsigned integer.
+template <size_t Size>
+struct word;
+
+template <>
+struct word<1> { using type = uint8_t; };
+
+template <>
+struct word<2> { using type = uint16_t; };
+
+template <>
+struct word<4> { using type = uint32_t; };
+
+template <>
+struct word<8> { using type = uint64_t; };
+
+[[nodiscard]] constexpr bool supported_size(const size_t size) noexcept
+{
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+    if (size == 16)
+        return true;
+#endif
+
+    return size == 1 || size == 2 || size == 4 || size == 8;
+}
+
+template <size_t Size>
+class cell
+{
+public:
+    using type = typename word<Size>::type;
+
+    static constexpr bool is_always_lock_free = std::atomic<type>::is_always_lock_free;
+
+    explicit cell(const type value) noexcept
+        : m_word{value} {}
+
+    [[nodiscard]] type load(const std::memory_order order) const noexcept
+    {
+        return m_word.load(order);
+    }
+
+    void store(const type value, const std::memory_order order) noexcept
+    {
+        m_word.store(value, order);
+    }
+
+    [[nodiscard]] type exchange(const type value, const std::memory_order order) noexcept
+    {
+        return m_word.exchange(value, order);
+    }
+
+    [[nodiscard]] bool compare_exchange_weak(
+        type& expected,
+        const type desired,
+        const std::memory_order success,
+        const std::memory_order failure) noexcept
+    {
+        return m_word.compare_exchange_weak(expected, desired, success, failure);
+    }
+
+    [[nodiscard]] bool compare_exchange_strong(
+        type& expected,
+        const type desired,
+        const std::memory_order success,
+        const std::memory_order failure) noexcept
+    {
+        return m_word.compare_exchange_strong(expected, desired, success, failure);
+    }
+
+#if defined(__cpp_lib_atomic_wait)
+    void wait(const type old, const std::memory_order order) const noexcept
+    {
+        m_word.wait(old, order);
+    }
+
+    void notify_one() noexcept { m_word.notify_one(); }
+
+    void notify_all() noexcept { m_word.notify_all(); }
+#endif
+
+private:
+    std::atomic<type> m_word;
+};
+
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+// std::atomic of 16 bytes goes through libatomic with GCC, which does not report it as lock
+// free. The legacy __sync builtins are expanded inline to CMPXCHG16B instead, which makes
+// every operation a full barrier and a load a compare-and-swap.
+template <>
+class cell<16>
+{
+public:
+    __extension__ typedef unsigned __int128 type;
+
+    static constexpr bool is_always_lock_free = true;
+
+    explicit cell(const type value) noexcept
+        : m_word{value} {}
+
+    [[nodiscard]] type load(std::memory_order) const noexcept
+    {
+        return __sync_val_compare_and_swap(&m_word, type{0}, type{0});
+    }
+
+    void store(const type value, const std::memory_order order) noexcept
+    {
+        static_cast<void>(exchange(value, order));
+    }
+
+    [[nodiscard]] type exchange(const type value, std::memory_order) noexcept
+    {
+        type expected = 0;
+        for (;;)
+        {
+            const type actual = __sync_val_compare_and_swap(&m_word, expected, value);
+            if (actual == expected)
+                return actual;
+
+            expected = actual;
+        }
+    }
+
+    [[nodiscard]] bool compare_exchange_weak(
+        type& expected,
+        const type desired,
+        const std::memory_order success,
+        const std::memory_order failure) noexcept
+    {
+        return compare_exchange_strong(expected, desired, success, failure);
+    }
+
+    [[nodiscard]] bool compare_exchange_strong(
+        type& expected, const type desired, std::memory_order, std::memory_order) noexcept
+    {
+        const type actual = __sync_val_compare_and_swap(&m_word, expected, desired);
+        if (actual == expected)
+            return true;
+
+        expected = actual;
+        return false;
+    }
+
+#if defined(__cpp_lib_atomic_wait)
+    // There is no futex of 16 bytes, so waiting polls.
+    void wait(const type old, const std::memory_order order) const noexcept
+    {
+        while (load(order) == old)
+            std::this_thread::yield();
+    }
+
+    void notify_one() noexcept {}
+
+    void notify_all() noexcept {}
+#endif
+
+private:
+    alignas(16) mutable type m_word;
+};
+#endif
+
+} // namespace details::atomic_optional_ns
+
+// An atomic optional for policies that keep the engagement state in the bytes of the value,
+// such as dze::sentinel, whose optionals are then a single word of up to 8 bytes, or of 16
+// bytes where CMPXCHG16B is available (e.g. with -mcx16). Engagement and value are published
+// together, so no lock is needed.
+//
+// Like std::atomic, compare_exchange compares object representations rather than using
+// operator==.
+template <typename T, typename Policy>
+class atomic_optional
+{
+public:
+    using value_type = optional<T, Policy>;
+
+private:
+    static_assert(!details::optional_ns::is_default_policy_v<Policy>,
+        "atomic_optional requires a policy that stores the engagement state in the value.");
+    static_assert(std::is_trivially_copyable_v<value_type>);
+
+    static_assert(
+        details::atomic_optional_ns::supported_size(sizeof(value_type)),
+        "atomic_optional requires optionals of 1, 2, 4 or 8 bytes, or of 16 bytes with "
+        "CMPXCHG16B enabled.");
+
+    using cell = details::atomic_optional_ns::cell<sizeof(value_type)>;
+    using word = typename cell::type;
+
+    static_assert(sizeof(word) == sizeof(value_type));
+
+public:
+    static constexpr bool is_always_lock_free = cell::is_always_lock_free;
+
+    atomic_optional() noexcept
+        : atomic_optional{value_type{}} {}
+
+    atomic_optional(nullopt_t) noexcept
+        : atomic_optional{} {}
+
+    atomic_optional(const value_type value) noexcept
+        : m_cell{to_word(value)} {}
+
+    atomic_optional(const atomic_optional&) = delete;
+    atomic_optional& operator=(const atomic_optional&) = delete;
+
+    [[nodiscard]] value_type load(
+        const std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        return from_word(m_cell.load(order));
+    }
+
+    [[nodiscard]] bool has_value(
+        const std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        return load(order).has_value();
+    }
+
+    void store(
+        const value_type value,
+        const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        m_cell.store(to_word(value), order);
+    }
+
+    void reset(const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        store(value_type{}, order);
+    }
+
+    value_type exchange(
+        const value_type value,
+        const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return from_word(m_cell.exchange(to_word(value), order));
+    }
+
+    // Claims the value, leaving this disengaged.
+    value_type take(const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return exchange(value_type{}, order);
+    }
+
+    // Stores value if this is disengaged and returns whether it did. value must not be the
+    // null representation, which would leave this disengaged while reporting success.
+    bool try_emplace(
+        const T& value, const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        const value_type opt = value;
+        DZE_OPTIONAL_CHECK(opt.has_value());
+
+        word expected = to_word(value_type{});
+        return m_cell.compare_exchange_strong(
+            expected, to_word(opt), order, failure_order(order));
+    }
+
+    bool compare_exchange_weak(
+        value_type& expected,
+        const value_type desired,
+        const std::memory_order success,
+        const std::memory_order failure) noexcept
+    {
+        word w = to_word(expected);
+        const bool result = m_cell.compare_exchange_weak(w, to_word(desired), success, failure);
+        expected = from_word(w);
+        return result;
+    }
+
+    bool compare_exchange_weak(
+        value_type& expected,
+        const value_type desired,
+        const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return compare_exchange_weak(expected, desired, order, failure_order(order));
+    }
+
+    bool compare_exchange_strong(
+        value_type& expected,
+        const value_type desired,
+        const std::memory_order success,
+        const std::memory_order failure) noexcept
+    {
+        word w = to_word(expected);
+        const bool result =
+            m_cell.compare_exchange_strong(w, to_word(desired), success, failure);
+        expected = from_word(w);
+        return result;
+    }
+
+    bool compare_exchange_strong(
+        value_type& expected,
+        const value_type desired,
+        const std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return compare_exchange_strong(expected, desired, order, failure_order(order));
+    }
+
+#if defined(__cpp_lib_atomic_wait)
+    // Blocks until the representation differs from that of old.
+    void wait(
+        const value_type old,
+        const std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+        m_cell.wait(to_word(old), order);
+    }
+
+    void notify_one() noexcept { m_cell.notify_one(); }
+
+    void notify_all() noexcept { m_cell.notify_all(); }
+#endif
+
+private:
+    [[nodiscard]] static word to_word(const value_type& value) noexcept
+    {
+        word result;
+        std::memcpy(&result, &value, sizeof(word));
+        return result;
+    }
+
+    [[nodiscard]] static value_type from_word(const word w) noexcept
+    {
+        value_type result;
+        std::memcpy(static_cast<void*>(&result), &w, sizeof(word));
+        return result;
+    }
+
+    [[nodiscard]] static constexpr std::memory_order failure_order(
+        const std::memory_order order) noexcept
+    {
+        switch (order)
+        {
+        case std::memory_order_acq_rel:
+            return std::memory_order_acquire;
+        case std::memory_order_release:
+            return std::memory_order_relaxed;
+        case std::memory_order_relaxed:
+        case std::memory_order_consume:
+        case std::memory_order_acquire:
+        case std::memory_order_seq_cst:
+            break;
+        }
+
+        return order;
+    }
+
+    cell m_cell;
+};
+
+} // namespace dze
@@ -1,9 +1,63 @@
 #pragma once
 
+#include <atomic>
+#include <cstdlib>
 #include <optional>
 
+#include "details/check.hpp"
+
+// DZE_OPTIONAL_THROW_BAD_ACCESS selects whether value() on a disengaged optional throws
+// bad_optional_access or calls std::abort. It defaults to whether exceptions are enabled, so
+// that value() is usable with -fno-exceptions.
+#ifndef DZE_OPTIONAL_THROW_BAD_ACCESS
+#define DZE_OPTIONAL_THROW_BAD_ACCESS DZE_OPTIONAL_HAS_EXCEPTIONS
+#endif
+
+#if DZE_OPTIONAL_THROW_BAD_ACCESS && !DZE_OPTIONAL_HAS_EXCEPTIONS
+#error "DZE_OPTIONAL_THROW_BAD_ACCESS requires exceptions."
+#endif
+
 namespace dze {
 
 using std::bad_optional_access;
 
+// Called by value() on a disengaged optional before the configured failure action, e.g. to
+// log or to throw an exception type of the application. The failure action still happens if
+// the handler returns.
+using bad_optional_access_handler = void (*)();
+
+namespace details::bad_access_ns {
+
+inline std::atomic<bad_optional_access_handler> handler{nullptr};
+
+} // namespace details::bad_access_ns
+
+// Returns the previous handler. Passing nullptr removes the handler.
+inline bad_optional_access_handler set_bad_optional_access_handler(
+    const bad_optional_access_handler h) noexcept
+{
+    return details::bad_access_ns::handler.exchange(h, std::memory_order_acq_rel);
+}
+
+[[nodiscard]] inline bad_optional_access_handler get_bad_optional_access_handler() noexcept
+{
+    return details::bad_access_ns::handler.load(std::memory_order_acquire);
+}
+
+namespace details {
+
+[[noreturn]] DZE_OPTIONAL_COLD inline void bad_optional_access_failure()
+{
+    if (const auto h = get_bad_optional_access_handler())
+        h();
+
+#if DZE_OPTIONAL_THROW_BAD_ACCESS
+    throw bad_optional_access{};
+#else
+    std::abort();
+#endif
+}
+
+} // namespace details
+
 } // namespace dze
@@ -0,0 +1,478 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <dze/requires.hpp>
+
+#include "bad_optional_access.hpp"
+#include "details/check.hpp"
+#include "nullopt.hpp"
+#include "optional.hpp"
+#include "relocate.hpp"
+#include "slab_pool.hpp"
+
+namespace dze {
+
+// A pointer-sized optional that keeps its value on the heap and is disengaged when the pointer
+// is null. It suits large values that are rarely set, which would otherwise make every
+// dze::optional as large as the value.
+//
+// Pool provides the storage for the values through
+//
+//   static void* allocate();
+//   static void deallocate(void*) noexcept;
+//
+// where the storage must fit a T. The default pool recycles storage through per-thread free
+// lists.
+template <typename T, typename Pool = slab_pool<std::remove_const_t<T>>>
+class boxed_optional
+{
+    static_assert(!std::is_same_v<std::remove_cv_t<T>, nullopt_t>);
+    static_assert(!std::is_same_v<std::remove_cv_t<T>, std::in_place_t>);
+    static_assert(!std::is_reference_v<T>);
+
+    using stored_type = std::remove_const_t<T>;
+
+public:
+    using value_type = T;
+    using pool_type = Pool;
+
+    constexpr boxed_optional() noexcept = default;
+
+    constexpr boxed_optional(nullopt_t) noexcept {}
+
+    template <typename U = T,
+        DZE_REQUIRES(
+            !std::is_same_v<boxed_optional, std::decay_t<U>> &&
+            !std::is_same_v<std::in_place_t, std::decay_t<U>> &&
+            std::is_constructible_v<T, U&&> &&
+            std::is_convertible_v<U&&, T>)>
+    boxed_optional(U&& value)
+        : m_ptr{create(std::forward<U>(value))} {}
+
+    template <typename U = T,
+        DZE_REQUIRES(
+            !std::is_same_v<boxed_optional, std::decay_t<U>> &&
+            !std::is_same_v<std::in_place_t, std::decay_t<U>> &&
+            std::is_constructible_v<T, U&&> &&
+            !std::is_convertible_v<U&&, T>)>
+    explicit boxed_optional(U&& value)
+        : m_ptr{create(std::forward<U>(value))} {}
+
+    template <typename... Args,
+        DZE_REQUIRES(std::is_constructible_v<T, Args&&...>)>
+    explicit boxed_optional(std::in_place_t, Args&&... args)
+        : m_ptr{create(std::forward<Args>(args)...)} {}
+
+    boxed_optional(const boxed_optional& other)
+        : m_ptr{other ? create(*other) : nullptr} {}
+
+    boxed_optional(boxed_optional&& other) noexcept
+        : m_ptr{std::exchange(other.m_ptr, nullptr)} {}
+
+    ~boxed_optional() { reset(); }
+
+    boxed_optional& operator=(nullopt_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    // Assigns to an engaged value rather than allocating a new one.
+    boxed_optional& operator=(const boxed_optional& other)
+    {
+        if (!other)
+            reset();
+        else if (m_ptr)
+            *m_ptr = *other;
+        else
+            m_ptr = create(*other);
+
+        return *this;
+    }
+
+    boxed_optional& operator=(boxed_optional&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            m_ptr = std::exchange(other.m_ptr, nullptr);
+        }
+
+        return *this;
+    }
+
+    template <typename U = T,
+        DZE_REQUIRES(
+            !std::is_same_v<boxed_optional, std::decay_t<U>> &&
+            std::is_constructible_v<T, U&&> &&
+            std::is_assignable_v<T&, U&&>)>
+    boxed_optional& operator=(U&& value)
+    {
+        if (m_ptr)
+            *m_ptr = std::forward<U>(value);
+        else
+            m_ptr = create(std::forward<U>(value));
+
+        return *this;
+    }
+
+    template <typename... Args,
+        DZE_REQUIRES(std::is_constructible_v<T, Args&&...>)>
+    T& emplace(Args&&... args)
+    {
+        reset();
+        m_ptr = create(std::forward<Args>(args)...);
+        return *m_ptr;
+    }
+
+    void reset() noexcept
+    {
+        if (m_ptr)
+        {
+            m_ptr->~T();
+            Pool::deallocate(const_cast<stored_type*>(m_ptr));
+            m_ptr = nullptr;
+        }
+    }
+
+    void swap(boxed_optional& other) noexcept { std::swap(m_ptr, other.m_ptr); }
+
+    constexpr const T* operator->() const noexcept
+    {
+        DZE_OPTIONAL_CHECK(m_ptr);
+
+        return m_ptr;
+    }
+
+    constexpr T* operator->() noexcept
+    {
+        DZE_OPTIONAL_CHECK(m_ptr);
+
+        return m_ptr;
+    }
+
+    constexpr const T& operator*() const& noexcept { return *operator->(); }
+
+    constexpr T& operator*() & noexcept { return *operator->(); }
+
+    constexpr const T&& operator*() const&& noexcept { return std::move(*operator->()); }
+
+    constexpr T&& operator*() && noexcept { return std::move(*operator->()); }
+
+    explicit constexpr operator bool() const noexcept { return m_ptr != nullptr; }
+
+    [[nodiscard]] constexpr bool has_value() const noexcept { return m_ptr != nullptr; }
+
+    [[nodiscard]] constexpr T& value() &
+    {
+        if (!m_ptr)
+            details::bad_optional_access_failure();
+
+        return *m_ptr;
+    }
+
+    [[nodiscard]] constexpr const T& value() const&
+    {
+        if (!m_ptr)
+            details::bad_optional_access_failure();
+
+        return *m_ptr;
+    }
+
+    [[nodiscard]] constexpr T&& value() &&
+    {
+        if (!m_ptr)
+            details::bad_optional_access_failure();
+
+        return std::move(*m_ptr);
+    }
+
+    [[nodiscard]] constexpr const T&& value() const&&
+    {
+        if (!m_ptr)
+            details::bad_optional_access_failure();
+
+        return std::move(*m_ptr);
+    }
+
+    template <typename U>
+    [[nodiscard]] constexpr T value_or(U&& default_value) const&
+    {
+        static_assert(std::is_copy_constructible_v<T>);
+        static_assert(std::is_convertible_v<U&&, T>);
+
+        return m_ptr ? *m_ptr : static_cast<T>(std::forward<U>(default_value));
+    }
+
+    template <typename U>
+    [[nodiscard]] constexpr T value_or(U&& default_value) &&
+    {
+        static_assert(std::is_move_constructible_v<T>);
+        static_assert(std::is_convertible_v<U&&, T>);
+
+        return m_ptr ? std::move(*m_ptr) : static_cast<T>(std::forward<U>(default_value));
+    }
+
+private:
+    template <typename... Args>
+    [[nodiscard]] static T* create(Args&&... args)
+    {
+        void* const storage = Pool::allocate();
+#if DZE_OPTIONAL_HAS_EXCEPTIONS
+        try
+        {
+            return ::new (storage) stored_type(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            Pool::deallocate(storage);
+            throw;
+        }
+#else
+        return ::new (storage) stored_type(std::forward<Args>(args)...);
+#endif
+    }
+
+    T* m_ptr = nullptr;
+};
+
+template <typename T>
+boxed_optional(T) -> boxed_optional<T>;
+
+template <typename T, typename Pool>
+struct is_trivially_relocatable<boxed_optional<T, Pool>> : std::true_type {};
+
+template <typename T, typename Pool1, typename U, typename Pool2,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() == std::declval<U>()), bool>)>
+[[nodiscard]] bool operator==(
+    const boxed_optional<T, Pool1>& lhs, const boxed_optional<U, Pool2>& rhs)
+{
+    return static_cast<bool>(lhs) == static_cast<bool>(rhs) && (!lhs || *lhs == *rhs);
+}
+
+template <typename T, typename Pool1, typename U, typename Pool2,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() != std::declval<U>()), bool>)>
+[[nodiscard]] bool operator!=(
+    const boxed_optional<T, Pool1>& lhs, const boxed_optional<U, Pool2>& rhs)
+{
+    return static_cast<bool>(lhs) != static_cast<bool>(rhs) ||
+        (static_cast<bool>(lhs) && *lhs != *rhs);
+}
+
+template <typename T, typename Pool1, typename U, typename Pool2,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() < std::declval<U>()), bool>)>
+[[nodiscard]] bool operator<(
+    const boxed_optional<T, Pool1>& lhs, const boxed_optional<U, Pool2>& rhs)
+{
+    return static_cast<bool>(rhs) && (!lhs || *lhs < *rhs);
+}
+
+template <typename T, typename Pool1, typename U, typename Pool2,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() > std::declval<U>()), bool>)>
+[[nodiscard]] bool operator>(
+    const boxed_optional<T, Pool1>& lhs, const boxed_optional<U, Pool2>& rhs)
+{
+    return static_cast<bool>(lhs) && (!rhs || *lhs > *rhs);
+}
+
+template <typename T, typename Pool1, typename U, typename Pool2,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() <= std::declval<U>()), bool>)>
+[[nodiscard]] bool operator<=(
+    const boxed_optional<T, Pool1>& lhs, const boxed_optional<U, Pool2>& rhs)
+{
+    return !lhs || (static_cast<bool>(rhs) && *lhs <= *rhs);
+}
+
+template <typename T, typename Pool1, typename U, typename Pool2,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() >= std::declval<U>()), bool>)>
+[[nodiscard]] bool operator>=(
+    const boxed_optional<T, Pool1>& lhs, const boxed_optional<U, Pool2>& rhs)
+{
+    return !rhs || (static_cast<bool>(lhs) && *lhs >= *rhs);
+}
+
+// Comparisons with nullopt.
+
+template <typename T, typename Pool>
+[[nodiscard]] bool operator==(const boxed_optional<T, Pool>& lhs, nullopt_t) noexcept
+{
+    return !lhs;
+}
+
+template <typename T, typename Pool>
+[[nodiscard]] bool operator==(nullopt_t, const boxed_optional<T, Pool>& rhs) noexcept
+{
+    return !rhs;
+}
+
+template <typename T, typename Pool>
+[[nodiscard]] bool operator!=(const boxed_optional<T, Pool>& lhs, nullopt_t) noexcept
+{
+    return static_cast<bool>(lhs);
+}
+
+template <typename T, typename Pool>
+[[nodiscard]] bool operator!=(nullopt_t, const boxed_optional<T, Pool>& rhs) noexcept
+{
+    return static_cast<bool>(rhs);
+}
+
+template <typename T, typename Pool>
+[[nodiscard]] bool operator<(const boxed_optional<T, Pool>&, nullopt_t) noexcept
+{
+    return false;
+}
+
+template <typename T, typename Pool>
+[[nodiscard]] bool operator<(nullopt_t, const boxed_optional<T, Pool>& rhs) noexcept
+{
+    return static_cast<bool>(rhs);
+}
+
+template <typename T, typename Pool>
+[[nodiscard]] bool operator>(const boxed_optional<T, Pool>& lhs, nullopt_t) noexcept
+{
+    return static_cast<bool>(lhs);
+}
+
+template <typename T, typename Pool>
+[[nodiscard]] bool operator>(nullopt_t, const boxed_optional<T, Pool>&) noexcept
+{
+    return false;
+}
+
+template <typename T, typename Pool>
+[[nodiscard]] bool operator<=(const boxed_optional<T, Pool>& lhs, nullopt_t) noexcept
+{
+    return !lhs;
+}
+
+template <typename T, typename Pool>
+[[nodiscard]] bool operator<=(nullopt_t, const boxed_optional<T, Pool>&) noexcept
+{
+    return true;
+}
+
+template <typename T, typename Pool>
+[[nodiscard]] bool operator>=(const boxed_optional<T, Pool>&, nullopt_t) noexcept
+{
+    return true;
+}
+
+template <typename T, typename Pool>
+[[nodiscard]] bool operator>=(nullopt_t, const boxed_optional<T, Pool>& rhs) noexcept
+{
+    return !rhs;
+}
+
+// Comparisons with value type.
+
+template <typename T, typename Pool, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() == std::declval<U>()), bool>)>
+[[nodiscard]] bool operator==(const boxed_optional<T, Pool>& lhs, const U& rhs)
+{
+    return lhs && *lhs == rhs;
+}
+
+template <typename T, typename Pool, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<U>() == std::declval<T>()), bool>)>
+[[nodiscard]] bool operator==(const U& lhs, const boxed_optional<T, Pool>& rhs)
+{
+    return rhs && lhs == *rhs;
+}
+
+template <typename T, typename Pool, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() != std::declval<U>()), bool>)>
+[[nodiscard]] bool operator!=(const boxed_optional<T, Pool>& lhs, const U& rhs)
+{
+    return !lhs || *lhs != rhs;
+}
+
+template <typename T, typename Pool, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<U>() != std::declval<T>()), bool>)>
+[[nodiscard]] bool operator!=(const U& lhs, const boxed_optional<T, Pool>& rhs)
+{
+    return !rhs || lhs != *rhs;
+}
+
+template <typename T, typename Pool, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() < std::declval<U>()), bool>)>
+[[nodiscard]] bool operator<(const boxed_optional<T, Pool>& lhs, const U& rhs)
+{
+    return !lhs || *lhs < rhs;
+}
+
+template <typename T, typename Pool, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<U>() < std::declval<T>()), bool>)>
+[[nodiscard]] bool operator<(const U& lhs, const boxed_optional<T, Pool>& rhs)
+{
+    return rhs && lhs < *rhs;
+}
+
+template <typename T, typename Pool, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() > std::declval<U>()), bool>)>
+[[nodiscard]] bool operator>(const boxed_optional<T, Pool>& lhs, const U& rhs)
+{
+    return lhs && *lhs > rhs;
+}
+
+template <typename T, typename Pool, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<U>() > std::declval<T>()), bool>)>
+[[nodiscard]] bool operator>(const U& lhs, const boxed_optional<T, Pool>& rhs)
+{
+    return !rhs || lhs > *rhs;
+}
+
+template <typename T, typename Pool, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() <= std::declval<U>()), bool>)>
+[[nodiscard]] bool operator<=(const boxed_optional<T, Pool>& lhs, const U& rhs)
+{
+    return !lhs || *lhs <= rhs;
+}
+
+template <typename T, typename Pool, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<U>() <= std::declval<T>()), bool>)>
+[[nodiscard]] bool operator<=(const U& lhs, const boxed_optional<T, Pool>& rhs)
+{
+    return rhs && lhs <= *rhs;
+}
+
+template <typename T, typename Pool, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() >= std::declval<U>()), bool>)>
+[[nodiscard]] bool operator>=(const boxed_optional<T, Pool>& lhs, const U& rhs)
+{
+    return lhs && *lhs >= rhs;
+}
+
+template <typename T, typename Pool, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<U>() >= std::declval<T>()), bool>)>
+[[nodiscard]] bool operator>=(const U& lhs, const boxed_optional<T, Pool>& rhs)
+{
+    return !rhs || lhs >= *rhs;
+}
+
+template <typename T, typename Pool>
+void swap(boxed_optional<T, Pool>& lhs, boxed_optional<T, Pool>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+// Hashes like dze::optional so that both can be used interchangeably as keys.
+template <typename T, typename Pool>
+struct hash<boxed_optional<T, Pool>>
+{
+    size_t operator()(const boxed_optional<T, Pool>& opt) const
+    {
+        using std::hash;
+
+        constexpr auto magic_disengaged_hash = static_cast<size_t>(-3333);
+        return opt ? hash<std::remove_const_t<T>>{}(*opt) : magic_disengaged_hash;
+    }
+};
+
+} // namespace dze
@@ -0,0 +1,402 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <dze/requires.hpp>
+
+#include "atomic_optional.hpp"
+#include "details/bit.hpp"
+#include "details/check.hpp"
+#include "optional.hpp"
+#include "sentinel.hpp"
+
+namespace dze {
+
+namespace details::concurrent_sentinel_map_ns {
+
+// Number of slots copied by a helper at a time during a resize.
+constexpr size_t chunk_size = 1024;
+
+// Inserters register in one of these, picked by the home slot of their key, so that a resize
+// can wait for those that started before it without all inserts contending on one counter.
+constexpr size_t stripe_count = 16;
+
+struct alignas(64) stripe
+{
+    std::atomic<uint32_t> writers{0};
+    // Number of keys claimed by the inserters of this stripe.
+    std::atomic<size_t> count{0};
+};
+
+} // namespace details::concurrent_sentinel_map_ns
+
+// A concurrent open addressing hash map for word-sized keys, whose slots hold atomic sentinel
+// optionals. An insert claims a slot with a single compare-and-swap from the empty key and
+// then publishes its value the same way, so neither inserts nor lookups take a lock, and
+// inserting an existing key costs no more than finding it. Keys cannot be erased.
+//
+// The map doubles when it is three quarters full. The thread that starts a resize and the
+// inserters that run into it cooperate in copying the table chunk by chunk, after waiting for
+// the inserts that started before the resize. Lookups never wait and keep reading the old
+// table until the copy is complete. The old tables are kept until the map is destroyed, as
+// lookups may still be reading them, which takes less memory than the current table.
+//
+// The values are sentinel optionals as well: NullValue cannot be inserted and marks a slot
+// whose key is claimed but whose value is not published yet. With V void, this is a set.
+template <
+    typename K,
+    typename V,
+    auto EmptyKey,
+    auto NullValue,
+    typename Hash = hash<sentinel<K, EmptyKey>>>
+class concurrent_sentinel_map
+{
+    static constexpr bool is_set = std::is_void_v<V>;
+
+    using key_optional = sentinel<K, EmptyKey>;
+    // Stands in for the values of sets, which do not exist.
+    using mapped_type = std::conditional_t<is_set, char, V>;
+    using value_optional = sentinel<mapped_type, NullValue>;
+    using key_cell = atomic_optional<K, typename key_optional::policy_type>;
+    using value_cell = atomic_optional<
+        typename value_optional::value_type, typename value_optional::policy_type>;
+
+    static_assert(std::is_integral_v<K> || std::is_enum_v<K>);
+    static_assert(key_cell::is_always_lock_free);
+    static_assert(is_set || value_cell::is_always_lock_free);
+
+    static constexpr K empty_key{EmptyKey};
+    static constexpr size_t min_capacity = 64;
+
+    struct table
+    {
+        explicit table(const size_t capacity)
+            : mask{capacity - 1}
+            , shift{64 - details::popcount(mask)}
+            , keys{std::make_unique<key_cell[]>(capacity)}
+            , values{is_set ? nullptr : std::make_unique<value_cell[]>(capacity)} {}
+
+        table(const table&) = delete;
+        table& operator=(const table&) = delete;
+
+        ~table() { delete next.load(std::memory_order_relaxed); }
+
+        [[nodiscard]] size_t capacity() const noexcept { return mask + 1; }
+
+        const size_t mask;
+        const unsigned shift;
+        const std::unique_ptr<key_cell[]> keys;
+        // Unused for sets.
+        const std::unique_ptr<value_cell[]> values;
+        details::concurrent_sentinel_map_ns::stripe stripes[
+            details::concurrent_sentinel_map_ns::stripe_count];
+        // The table being migrated to, which owns it.
+        std::atomic<table*> next{nullptr};
+        std::atomic<size_t> claimed_chunks{0};
+        std::atomic<size_t> copied_chunks{0};
+    };
+
+    enum class status
+    {
+        inserted,
+        found,
+        full
+    };
+
+public:
+    using value_type = V;
+    using optional_type = value_optional;
+
+    // Makes room for capacity keys without resizing.
+    explicit concurrent_sentinel_map(const size_t capacity = 0)
+        : m_first{std::make_unique<table>(round_up(capacity))}
+        , m_current{m_first.get()} {}
+
+    concurrent_sentinel_map(const concurrent_sentinel_map&) = delete;
+    concurrent_sentinel_map& operator=(const concurrent_sentinel_map&) = delete;
+
+    // Returns the value of key and whether it was inserted. Of concurrent inserts of the same
+    // key, exactly one inserts its value and all return that value. key must not be the empty
+    // key and value must not be the null value.
+    template <typename U = V, DZE_REQUIRES(!std::is_void_v<U>)>
+    std::pair<mapped_type, bool> insert(const K key, const mapped_type value)
+    {
+        const value_optional opt = value;
+        DZE_OPTIONAL_CHECK(opt.has_value());
+
+        if (const value_optional existing = find(key))
+            return {*existing, false};
+
+        value_optional result;
+        const bool inserted = insert_key(key, [&](table& t, const size_t slot) {
+            value_optional expected;
+            if (t.values[slot].compare_exchange_strong(
+                    expected, opt, std::memory_order_acq_rel))
+            {
+                result = opt;
+                return true;
+            }
+
+            result = expected;
+            return false;
+        });
+
+        return {*result, inserted};
+    }
+
+    // Returns whether key was inserted. key must not be the empty key.
+    template <typename U = V, DZE_REQUIRES(std::is_void_v<U>)>
+    bool insert(const K key)
+    {
+        return !contains(key) && insert_key(key, [](table&, size_t) { return false; });
+    }
+
+    // The value of key, or nullopt if key has not been inserted. Never waits.
+    template <typename U = V, DZE_REQUIRES(!std::is_void_v<U>)>
+    [[nodiscard]] optional_type find(const K key) const noexcept
+    {
+        const table& t = *m_current.load(std::memory_order_acquire);
+        const auto [slot, present] = find_slot(t, key);
+        return present ? t.values[slot].load(std::memory_order_acquire) : optional_type{};
+    }
+
+    [[nodiscard]] bool contains(const K key) const noexcept
+    {
+        if constexpr (is_set)
+        {
+            const table& t = *m_current.load(std::memory_order_acquire);
+            return find_slot(t, key).second;
+        }
+        else
+            return find(key).has_value();
+    }
+
+    // Exact only when no insert is in progress.
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return total(*m_current.load(std::memory_order_acquire));
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return m_current.load(std::memory_order_acquire)->capacity();
+    }
+
+private:
+    [[nodiscard]] static size_t round_up(const size_t count) noexcept
+    {
+        size_t result = min_capacity;
+        while (max_size_for(result) < count)
+            result *= 2;
+
+        return result;
+    }
+
+    [[nodiscard]] static constexpr size_t max_size_for(const size_t capacity) noexcept
+    {
+        return capacity / 4 * 3;
+    }
+
+    [[nodiscard]] static size_t home(const table& t, const K key) noexcept
+    {
+        return details::fibonacci_hash(Hash{}(key_optional{key}), t.shift);
+    }
+
+    [[nodiscard]] static details::concurrent_sentinel_map_ns::stripe& stripe_of(
+        table& t, const size_t slot) noexcept
+    {
+        return t.stripes[slot % details::concurrent_sentinel_map_ns::stripe_count];
+    }
+
+    // Returns the slot of key and whether key is there, or the first free slot of its probe
+    // sequence and false.
+    [[nodiscard]] static std::pair<size_t, bool> find_slot(
+        const table& t, const K key) noexcept
+    {
+        DZE_OPTIONAL_CHECK(key != empty_key);
+
+        size_t slot = home(t, key);
+        for (size_t probes = 0; probes <= t.mask; ++probes, slot = (slot + 1) & t.mask)
+        {
+            const key_optional current = t.keys[slot].load(std::memory_order_acquire);
+            if (!current)
+                return {slot, false};
+
+            if (*current == key)
+                return {slot, true};
+        }
+
+        return {t.capacity(), false};
+    }
+
+    // Publish(table, slot) publishes the value of a claimed key and returns whether it did.
+    template <typename Publish>
+    bool insert_key(const K key, Publish publish)
+    {
+        for (table* t = m_current.load(std::memory_order_acquire);;)
+        {
+            auto& s = stripe_of(*t, home(*t, key));
+
+            // Pairs with the resize storing next and then loading writers, so that either this
+            // sees the resize or the resize waits for this insert.
+            s.writers.fetch_add(1, std::memory_order_seq_cst);
+            if (t->next.load(std::memory_order_seq_cst) != nullptr)
+            {
+                s.writers.fetch_sub(1, std::memory_order_release);
+                t = migrate(t);
+                continue;
+            }
+
+            const auto [st, slot] = claim(*t, s, key);
+            bool inserted = false;
+            if constexpr (is_set)
+                inserted = st == status::inserted;
+            else if (st != status::full)
+                inserted = publish(*t, slot);
+
+            s.writers.fetch_sub(1, std::memory_order_release);
+
+            if (st != status::full)
+                return inserted;
+
+            t = grow(t);
+        }
+    }
+
+    // Claims a slot for key unless it is already present or the table is full, and returns
+    // the slot of key.
+    [[nodiscard]] static std::pair<status, size_t> claim(
+        table& t, details::concurrent_sentinel_map_ns::stripe& s, const K key) noexcept
+    {
+        using details::concurrent_sentinel_map_ns::stripe_count;
+
+        const size_t max_size = max_size_for(t.capacity());
+        for (;;)
+        {
+            const auto [slot, present] = find_slot(t, key);
+            if (present)
+                return {status::found, slot};
+
+            // The total is only counted when the stripe of key is past its share.
+            if (slot == t.capacity() ||
+                (s.count.load(std::memory_order_relaxed) >= max_size / stripe_count &&
+                    total(t) >= max_size))
+                return {status::full, slot};
+
+            key_optional expected;
+            if (t.keys[slot].compare_exchange_strong(
+                    expected, key_optional{key}, std::memory_order_acq_rel))
+            {
+                s.count.fetch_add(1, std::memory_order_relaxed);
+                return {status::inserted, slot};
+            }
+
+            // Another key took the slot, or the same key did, which the next probe finds.
+        }
+    }
+
+    [[nodiscard]] static size_t total(const table& t) noexcept
+    {
+        size_t result = 0;
+        for (const auto& s : t.stripes)
+            result += s.count.load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+    // Starts a resize of t unless one has started and helps with it.
+    [[nodiscard]] table* grow(table* const t)
+    {
+        if (t->next.load(std::memory_order_acquire) == nullptr)
+        {
+            auto bigger = std::make_unique<table>(t->capacity() * 2);
+            table* expected = nullptr;
+            if (t->next.compare_exchange_strong(
+                    expected, bigger.get(), std::memory_order_seq_cst))
+                bigger.release();
+        }
+
+        return migrate(t);
+    }
+
+    // Copies t into its next table together with the other helpers, waits for the copy to
+    // complete and returns the next table.
+    [[nodiscard]] table* migrate(table* const t)
+    {
+        using details::concurrent_sentinel_map_ns::chunk_size;
+
+        table* const next = t->next.load(std::memory_order_acquire);
+
+        // Waits for the inserts that did not see the resize, after which t no longer changes.
+        for (auto& s : t->stripes)
+        {
+            while (s.writers.load(std::memory_order_seq_cst) != 0)
+                std::this_thread::yield();
+        }
+
+        const size_t chunks = (t->capacity() + chunk_size - 1) / chunk_size;
+        for (;;)
+        {
+            const size_t chunk = t->claimed_chunks.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunks)
+                break;
+
+            const size_t first = chunk * chunk_size;
+            copy(*t, *next, first, std::min(t->capacity(), first + chunk_size));
+            t->copied_chunks.fetch_add(1, std::memory_order_release);
+        }
+
+        while (t->copied_chunks.load(std::memory_order_acquire) != chunks)
+            std::this_thread::yield();
+
+        table* expected = t;
+        m_current.compare_exchange_strong(expected, next, std::memory_order_acq_rel);
+        return next;
+    }
+
+    // Only helpers write to the next table until the copy is complete, and all their keys
+    // are distinct.
+    static void copy(const table& from, table& to, const size_t first, const size_t last)
+    {
+        for (size_t i = first; i != last; ++i)
+        {
+            const key_optional key = from.keys[i].load(std::memory_order_relaxed);
+            if (!key)
+                continue;
+
+            size_t slot = home(to, *key);
+            for (;;)
+            {
+                key_optional expected;
+                if (to.keys[slot].compare_exchange_strong(
+                        expected, key, std::memory_order_relaxed))
+                    break;
+
+                slot = (slot + 1) & to.mask;
+            }
+
+            if constexpr (!is_set)
+            {
+                to.values[slot].store(
+                    from.values[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+
+            stripe_of(to, home(to, *key)).count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    const std::unique_ptr<table> m_first;
+    std::atomic<table*> m_current;
+};
+
+template <typename K, auto EmptyKey, typename Hash = hash<sentinel<K, EmptyKey>>>
+using concurrent_sentinel_set = concurrent_sentinel_map<K, void, EmptyKey, 0, Hash>;
+
+} // namespace dze
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace dze::details {
+
+// Number of trailing zero bits. x must not be zero.
+[[nodiscard]] inline unsigned countr_zero(const uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<unsigned>(index);
+#else
+    unsigned count = 0;
+    for (auto bits = x; (bits & 1) == 0; bits >>= 1)
+        ++count;
+    return count;
+#endif
+}
+
+[[nodiscard]] inline unsigned popcount(const uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_popcountll(x));
+#else
+    unsigned count = 0;
+    for (auto bits = x; bits != 0; bits &= bits - 1)
+        ++count;
+    return count;
+#endif
+}
+
+// The top 64 - shift bits of hash times 2^64 divided by the golden ratio. Fibonacci hashing
+// keeps the high bits of the product, which depend on all the bits of the hash, so it spreads
+// hashes that are the identity of an integer key.
+[[nodiscard]] constexpr size_t fibonacci_hash(
+    const uint64_t hash, const unsigned shift) noexcept
+{
+    return static_cast<size_t>(hash * 0x9e3779b97f4a7c15u >> shift);
+}
+
+// Calls f with the index of each set bit of mask in ascending order.
+template <typename F>
+void for_each_set_bit(uint64_t mask, F&& f)
+{
+    for (; mask != 0; mask &= mask - 1)
+        f(countr_zero(mask));
+}
+
+} // namespace dze::details
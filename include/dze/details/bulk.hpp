@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../optional.hpp"
+
+namespace dze::details::optional_ns {
+
+// Number of optionals whose engagement is packed into one mask word.
+constexpr size_t block_size = 64;
+
+// True when the storage of a disengaged optional holds a valid object of the contained type.
+// Bulk operations then read the storage unconditionally and mask out the nulls afterwards,
+// which keeps their loops free of branches. Arithmetic types qualify as any object
+// representation is a valid value.
+template <typename T, typename Policy>
+constexpr bool representation_is_value_v =
+    !is_default_policy_v<Policy> &&
+    std::is_arithmetic_v<T> &&
+    !std::is_same_v<std::remove_cv_t<T>, bool>;
+
+template <typename T, typename Policy, typename Predicate>
+[[nodiscard]] bool matches(const optional<T, Policy>& opt, Predicate& pred)
+{
+    if constexpr (representation_is_value_v<T, Policy>)
+        return opt.has_value() & static_cast<bool>(pred(access::representation(opt)));
+    else
+        return opt.has_value() && static_cast<bool>(pred(*opt));
+}
+
+// Bit i of the result is set when bit(i) returns true.
+// count must not be larger than block_size.
+template <typename F>
+[[nodiscard]] uint64_t make_mask(const size_t count, F bit)
+{
+    uint64_t mask = 0;
+    if (count == block_size)
+    {
+        // With a constant trip count and the results collected into bytes first, compilers
+        // vectorize both the evaluation and the packing of the bits.
+        uint8_t bits[block_size];
+        for (size_t i = 0; i != block_size; ++i)
+            bits[i] = static_cast<uint8_t>(bit(i));
+        for (size_t i = 0; i != block_size; ++i)
+            mask |= static_cast<uint64_t>(bits[i]) << i;
+    }
+    else
+    {
+        for (size_t i = 0; i != count; ++i)
+            mask |= static_cast<uint64_t>(bit(i)) << i;
+    }
+
+    return mask;
+}
+
+// Bit i of the result is set when first[i] is engaged and pred(*first[i]) holds.
+// count must not be larger than block_size.
+template <typename T, typename Policy, typename Predicate>
+[[nodiscard]] uint64_t match_mask(
+    const optional<T, Policy>* const first, const size_t count, Predicate pred)
+{
+    return make_mask(count, [&](const size_t i) { return matches(first[i], pred); });
+}
+
+// Bit i of the result is set when first[i] is engaged. Works for any optional-like type.
+// count must not be larger than block_size.
+template <typename Opt>
+[[nodiscard]] uint64_t engagement_mask(Opt* const first, const size_t count)
+{
+    return make_mask(count, [&](const size_t i) { return first[i].has_value(); });
+}
+
+} // namespace dze::details::optional_ns
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cassert>
+
+// DZE_OPTIONAL_CHECK_LEVEL selects what happens when a precondition on engagement, such as
+// that of operator*, is checked:
+//   0: The condition is not checked but assumed to hold, which lets compilers drop later
+//      checks of the same condition.
+//   1: The condition is asserted. The default. Without assertions, i.e. with NDEBUG defined,
+//      it is assumed like with 0.
+//   2: The program traps if the condition does not hold, regardless of NDEBUG.
+#ifndef DZE_OPTIONAL_CHECK_LEVEL
+#define DZE_OPTIONAL_CHECK_LEVEL 1
+#endif
+
+#if DZE_OPTIONAL_CHECK_LEVEL < 0 || DZE_OPTIONAL_CHECK_LEVEL > 2
+#error "DZE_OPTIONAL_CHECK_LEVEL must be 0, 1 or 2."
+#endif
+
+// Policies may implement is_engaged with library calls such as std::memcmp, which Clang
+// considers to have side effects and then ignores in __builtin_assume and [[assume]].
+// Branching to an unreachable point works for any condition without side effects.
+#if defined(__GNUC__)
+#define DZE_OPTIONAL_ASSUME(...) \
+    do { if (!(__VA_ARGS__)) __builtin_unreachable(); } while (false)
+#elif defined(_MSC_VER)
+#define DZE_OPTIONAL_ASSUME(...) __assume(__VA_ARGS__)
+#else
+#define DZE_OPTIONAL_ASSUME(...) static_cast<void>(0)
+#endif
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define DZE_OPTIONAL_HAS_EXCEPTIONS 1
+#else
+#define DZE_OPTIONAL_HAS_EXCEPTIONS 0
+#endif
+
+// For failure paths that are kept out of line so that they cost their callers no more than a
+// branch and a call.
+#if defined(__GNUC__)
+#define DZE_OPTIONAL_COLD __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define DZE_OPTIONAL_COLD __declspec(noinline)
+#else
+#define DZE_OPTIONAL_COLD
+#endif
+
+#if defined(__GNUC__)
+#define DZE_OPTIONAL_TRAP() __builtin_trap()
+#elif defined(_MSC_VER)
+#define DZE_OPTIONAL_TRAP() __fastfail(7)
+#else
+#include <cstdlib>
+#define DZE_OPTIONAL_TRAP() std::abort()
+#endif
+
+#if DZE_OPTIONAL_CHECK_LEVEL == 0 || (DZE_OPTIONAL_CHECK_LEVEL == 1 && defined(NDEBUG))
+#define DZE_OPTIONAL_CHECK(...) DZE_OPTIONAL_ASSUME(__VA_ARGS__)
+#elif DZE_OPTIONAL_CHECK_LEVEL == 1
+#define DZE_OPTIONAL_CHECK(...) assert(__VA_ARGS__)
+#else
+#define DZE_OPTIONAL_CHECK(...) \
+    do { if (!(__VA_ARGS__)) DZE_OPTIONAL_TRAP(); } while (false)
+#endif
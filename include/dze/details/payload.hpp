@@ -2,12 +2,15 @@
 
 #include <cassert>
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
 #include <type_traits>
 #include <utility>
 
 #include <dze/type_traits.hpp>
 
+#include "check.hpp"
+
 namespace dze::details::optional_ns {
 
 // This policy provides equivalent semantics with std::optional.
@@ -16,6 +19,16 @@ struct default_policy {};
 template <typename Policy>
 constexpr auto is_default_policy_v = std::is_same_v<Policy, default_policy>;
 
+// A policy may declare `static constexpr bool null_sorts_first = true;` to promise that its
+// null representation is a valid object of the contained type that compares less than every
+// engaged value. Optionals of such policies are ordered by comparing their storage directly.
+template <typename Policy, typename = void>
+constexpr bool null_sorts_first_v = false;
+
+template <typename Policy>
+constexpr bool null_sorts_first_v<Policy, std::void_t<decltype(Policy::null_sorts_first)>> =
+    Policy::null_sorts_first;
+
 // This class template manages construction/destruction of
 // the contained value for a dze::optional.
 template <typename T, typename Policy>
@@ -73,6 +86,18 @@ public:
             stored_type(std::forward<Args>(args)...);
     }
 
+    // Constructs the contained value directly from the result of f(), so that a prvalue result
+    // is not moved.
+    template <typename F>
+    void construct_with(F&& f)
+        noexcept(std::is_nothrow_invocable_v<F&&> &&
+            std::is_nothrow_constructible_v<stored_type, std::invoke_result_t<F&&>>)
+    {
+        ::new
+            (static_cast<void*>(std::addressof(m_pack.storage.value)))
+            stored_type(std::invoke(std::forward<F>(f)));
+    }
+
     template <typename P = Policy,
         DZE_REQUIRES(is_default_policy_v<P>)>
     constexpr void set() noexcept
@@ -131,7 +156,7 @@ public:
 
     constexpr void unchecked_reset() noexcept
     {
-        assert(is_engaged());
+        DZE_OPTIONAL_CHECK(is_engaged());
 
         get().~stored_type();
         if constexpr (is_default_policy_v<Policy>)
@@ -140,6 +165,17 @@ public:
             Policy::null_initialize(m_pack.storage_address());
     }
 
+    // Disengages without destroying the contained value, which is abandoned in place.
+    constexpr void unchecked_release() noexcept
+    {
+        DZE_OPTIONAL_CHECK(is_engaged());
+
+        if constexpr (is_default_policy_v<Policy>)
+            m_pack.is_engaged = false;
+        else
+            Policy::null_initialize(m_pack.storage_address());
+    }
+
     constexpr void reset() noexcept
     {
         if (is_engaged())
@@ -149,14 +185,29 @@ public:
     // Apply the erased const qualifier.
     [[nodiscard]] constexpr const T& get() const noexcept
     {
-        assert(is_engaged());
+        DZE_OPTIONAL_CHECK(is_engaged());
 
         return m_pack.storage.value;
     }
 
     [[nodiscard]] constexpr T& get() noexcept
     {
-        assert(is_engaged());
+        DZE_OPTIONAL_CHECK(is_engaged());
+
+        return m_pack.storage.value;
+    }
+
+    // Storage for writing the object representation of a trivially copyable value into.
+    [[nodiscard]] std::byte* raw_storage() noexcept
+    {
+        return reinterpret_cast<std::byte*>(std::addressof(m_pack.storage.value));
+    }
+
+    // Unlike get(), this does not require the payload to be engaged. It is only meaningful
+    // for policies whose null representation is a valid object of the contained type.
+    [[nodiscard]] constexpr const T& representation() const noexcept
+    {
+        static_assert(!is_default_policy_v<Policy>);
 
         return m_pack.storage.value;
     }
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace dze::details::sort_ns {
+
+template <size_t Size>
+struct unsigned_of_size;
+
+template <>
+struct unsigned_of_size<1> { using type = uint8_t; };
+
+template <>
+struct unsigned_of_size<2> { using type = uint16_t; };
+
+template <>
+struct unsigned_of_size<4> { using type = uint32_t; };
+
+template <>
+struct unsigned_of_size<8> { using type = uint64_t; };
+
+template <typename T>
+constexpr bool is_radix_sortable_v =
+    std::is_arithmetic_v<T> &&
+    !std::is_same_v<T, bool> &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) &&
+    (!std::is_floating_point_v<T> || std::numeric_limits<T>::is_iec559);
+
+// Maps a value to an unsigned integer whose ordering matches the ordering of the values.
+// Negative floating point values have all their bits flipped, positive ones only the sign bit.
+// As a result, -0.0 sorts before +0.0 and NaNs sort to the ends according to their sign.
+template <typename T>
+[[nodiscard]] auto radix_key(const T value) noexcept
+{
+    using key_type = typename unsigned_of_size<sizeof(T)>::type;
+
+    constexpr auto bits = sizeof(T) * 8;
+    constexpr auto sign = static_cast<key_type>(key_type{1} << (bits - 1));
+
+    key_type key;
+    std::memcpy(&key, &value, sizeof(T));
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        const auto mask = static_cast<key_type>(-static_cast<key_type>(key >> (bits - 1)));
+        return static_cast<key_type>(key ^ (mask | sign));
+    }
+    else if constexpr (std::is_signed_v<T>)
+        return static_cast<key_type>(key ^ sign);
+    else
+        return key;
+}
+
+// LSD radix sort with 8 bit digits. buffer must have room for last - first elements.
+// Passes in which all the keys share the same digit are skipped.
+template <typename T>
+void radix_sort(T* const first, T* const last, T* const buffer) noexcept
+{
+    static_assert(is_radix_sortable_v<T>);
+
+    constexpr size_t passes = sizeof(T);
+    constexpr size_t radix = 256;
+
+    const auto size = static_cast<size_t>(last - first);
+    if (size < 2)
+        return;
+
+    std::array<std::array<size_t, radix>, passes> counts{};
+    for (auto it = first; it != last; ++it)
+    {
+        const auto key = radix_key(*it);
+        for (size_t pass = 0; pass != passes; ++pass)
+            ++counts[pass][(key >> (pass * 8)) & 0xFF];
+    }
+
+    T* src = first;
+    T* dst = buffer;
+    for (size_t pass = 0; pass != passes; ++pass)
+    {
+        auto& offsets = counts[pass];
+        if (offsets[(radix_key(*src) >> (pass * 8)) & 0xFF] == size)
+            continue;
+
+        size_t sum = 0;
+        for (auto& offset : offsets)
+        {
+            const auto count = offset;
+            offset = sum;
+            sum += count;
+        }
+
+        for (auto it = src; it != src + size; ++it)
+            dst[offsets[(radix_key(*it) >> (pass * 8)) & 0xFF]++] = *it;
+
+        std::swap(src, dst);
+    }
+
+    if (src != first)
+        std::memcpy(first, src, size * sizeof(T));
+}
+
+} // namespace dze::details::sort_ns
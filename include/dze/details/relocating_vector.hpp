@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../relocate.hpp"
+
+namespace dze::details {
+
+// The subset of std::vector that the containers of this library use, growing by relocating
+// its elements: reallocating a vector of trivially relocatable elements, such as optionals of
+// types that own heap memory, copies bytes instead of moving and destroying each element.
+// Types whose relocation may throw are copied when they can be, as std::vector does, so
+// growth keeps the elements intact if it throws.
+template <typename T>
+class relocating_vector
+{
+    static constexpr bool nothrow_relocatable =
+        is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    relocating_vector() = default;
+
+    relocating_vector(const relocating_vector& other)
+        : m_data{allocate(other.m_size)}
+        , m_capacity{other.m_size}
+    {
+        // The destructor does not run if copying throws.
+        allocation_guard g{m_data, m_capacity};
+        std::uninitialized_copy(other.begin(), other.end(), m_data);
+        m_size = other.m_size;
+        g.data = nullptr;
+    }
+
+    relocating_vector(relocating_vector&& other) noexcept
+        : m_data{std::exchange(other.m_data, nullptr)}
+        , m_size{std::exchange(other.m_size, 0)}
+        , m_capacity{std::exchange(other.m_capacity, 0)} {}
+
+    relocating_vector& operator=(const relocating_vector& other)
+    {
+        if (this != &other)
+            relocating_vector{other}.swap(*this);
+
+        return *this;
+    }
+
+    relocating_vector& operator=(relocating_vector&& other) noexcept
+    {
+        if (this != &other)
+            relocating_vector{std::move(other)}.swap(*this);
+
+        return *this;
+    }
+
+    ~relocating_vector()
+    {
+        std::destroy(begin(), end());
+        deallocate(m_data, m_capacity);
+    }
+
+    void swap(relocating_vector& other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_capacity, other.m_capacity);
+    }
+
+    friend void swap(relocating_vector& lhs, relocating_vector& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    void reserve(const size_t count)
+    {
+        if (count > m_capacity)
+            reallocate(count);
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (m_size != m_capacity)
+        {
+            T* const result = ::new (static_cast<void*>(m_data + m_size))
+                T(std::forward<Args>(args)...);
+            ++m_size;
+            return *result;
+        }
+
+        // Constructs the new element first, so that args may refer to the old elements.
+        const size_t capacity = std::max<size_t>(2 * m_capacity, 1);
+        allocation_guard g{allocate(capacity), capacity};
+        T* const result = ::new (static_cast<void*>(g.data + m_size))
+            T(std::forward<Args>(args)...);
+        g.constructed = result;
+        transfer(g.data);
+
+        adopt(g, capacity);
+        ++m_size;
+        return *result;
+    }
+
+    void clear() noexcept
+    {
+        std::destroy(begin(), end());
+        m_size = 0;
+    }
+
+    [[nodiscard]] T& operator[](const size_t index) noexcept { return m_data[index]; }
+
+    [[nodiscard]] const T& operator[](const size_t index) const noexcept
+    {
+        return m_data[index];
+    }
+
+    [[nodiscard]] T* data() noexcept { return m_data; }
+
+    [[nodiscard]] const T* data() const noexcept { return m_data; }
+
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    [[nodiscard]] T* begin() noexcept { return m_data; }
+
+    [[nodiscard]] const T* begin() const noexcept { return m_data; }
+
+    [[nodiscard]] T* end() noexcept { return m_data + m_size; }
+
+    [[nodiscard]] const T* end() const noexcept { return m_data + m_size; }
+
+private:
+    [[nodiscard]] static T* allocate(const size_t count)
+    {
+        return count == 0 ? nullptr : std::allocator<T>{}.allocate(count);
+    }
+
+    static void deallocate(T* const data, const size_t count) noexcept
+    {
+        if (data)
+            std::allocator<T>{}.deallocate(data, count);
+    }
+
+    // Moves the elements to data, which has room for them. Only throws, with the elements
+    // left in place, when relocation may throw.
+    void transfer(T* const data) noexcept(nothrow_relocatable)
+    {
+        if constexpr (nothrow_relocatable)
+            uninitialized_relocate(begin(), end(), data);
+        else
+        {
+            if constexpr (std::is_copy_constructible_v<T>)
+                std::uninitialized_copy(begin(), end(), data);
+            else
+                std::uninitialized_move(begin(), end(), data);
+
+            std::destroy(begin(), end());
+        }
+    }
+
+    // Frees new storage, and destroys the element constructed in it, unless released.
+    struct allocation_guard
+    {
+        T* data;
+        size_t capacity;
+        T* constructed = nullptr;
+
+        ~allocation_guard()
+        {
+            if (!data)
+                return;
+
+            if (constructed)
+                constructed->~T();
+            deallocate(data, capacity);
+        }
+    };
+
+    // Replaces the storage with that of g, to which the elements have been transferred.
+    void adopt(allocation_guard& g, const size_t capacity) noexcept
+    {
+        deallocate(m_data, m_capacity);
+        m_data = std::exchange(g.data, nullptr);
+        m_capacity = capacity;
+    }
+
+    void reallocate(const size_t capacity)
+    {
+        allocation_guard g{allocate(capacity), capacity};
+        transfer(g.data);
+        adopt(g, capacity);
+    }
+
+    T* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_capacity = 0;
+};
+
+} // namespace dze::details
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "details/bit.hpp"
+#include "details/check.hpp"
+#include "optional.hpp"
+#include "optional_reference.hpp"
+
+namespace dze {
+
+namespace details::frozen_map_ns {
+
+// std::hash is not constexpr, so keys are hashed as integers.
+struct integer_hash
+{
+    template <typename K>
+    [[nodiscard]] constexpr size_t operator()(const K key) const noexcept
+    {
+        if constexpr (std::is_enum_v<K>)
+            return static_cast<size_t>(static_cast<std::underlying_type_t<K>>(key));
+        else
+            return static_cast<size_t>(key);
+    }
+};
+
+[[nodiscard]] constexpr size_t table_size(const size_t count) noexcept
+{
+    size_t result = 2;
+    while (result < count * 2)
+        result *= 2;
+
+    return result;
+}
+
+// Not constexpr, so that reaching them while building a table at compile time is an error
+// that names the problem.
+[[noreturn]] inline void duplicate_key() noexcept { DZE_OPTIONAL_TRAP(); }
+
+[[noreturn]] inline void empty_key_entry() noexcept { DZE_OPTIONAL_TRAP(); }
+
+} // namespace details::frozen_map_ns
+
+// An immutable open addressing hash map built from N entries, meant to be built at compile
+// time into a constexpr variable, which places it in read-only data with no construction at
+// startup. The table is at most half full and records the longest probe sequence of its keys,
+// so a lookup compares that many slots unconditionally and never branches on what it reads.
+//
+// Free slots hold EmptyKey, which is the representation of a disengaged dze::sentinel of the
+// key type. The keys are stored as plain keys rather than as sentinel optionals because the
+// null state of a sentinel optional is written with memcpy, which is not constexpr. Hash must
+// be callable in constant expressions. V must be default constructible, which fills the free
+// slots.
+template <
+    typename K,
+    typename V,
+    size_t N,
+    auto EmptyKey,
+    typename Hash = details::frozen_map_ns::integer_hash>
+class frozen_map
+{
+    static_assert(std::is_integral_v<K> || std::is_enum_v<K>);
+    static_assert(N != 0);
+
+    static constexpr K empty_key{EmptyKey};
+    static constexpr size_t capacity = details::frozen_map_ns::table_size(N);
+    static constexpr unsigned shift = [] {
+        unsigned bits = 0;
+        while ((size_t{1} << bits) < capacity)
+            ++bits;
+
+        return 64 - bits;
+    }();
+
+public:
+    using key_type = K;
+    using value_type = V;
+
+    // The keys must be distinct and must not be the empty key.
+    constexpr explicit frozen_map(const std::pair<K, V> (&entries)[N])
+        : m_keys{}
+        , m_values{}
+    {
+        for (auto& key : m_keys)
+            key = empty_key;
+
+        for (const auto& [key, value] : entries)
+        {
+            if (key == empty_key)
+                details::frozen_map_ns::empty_key_entry();
+
+            size_t slot = home(key);
+            size_t probe = 0;
+            for (; m_keys[slot] != empty_key; slot = next(slot), ++probe)
+            {
+                if (m_keys[slot] == key)
+                    details::frozen_map_ns::duplicate_key();
+            }
+
+            m_keys[slot] = key;
+            m_values[slot] = value;
+            if (probe > m_max_probe)
+                m_max_probe = probe;
+        }
+    }
+
+    // The value of key, or nullopt.
+    [[nodiscard]] constexpr optional_reference<const V> find(const K key) const noexcept
+    {
+        const size_t slot = find_slot(key);
+        return slot == capacity ? optional_reference<const V>{} : m_values[slot];
+    }
+
+    // A copy of the value of key, or nullopt.
+    [[nodiscard]] constexpr optional<V> get(const K key) const
+    {
+        const size_t slot = find_slot(key);
+        return slot == capacity ? optional<V>{} : optional<V>{m_values[slot]};
+    }
+
+    [[nodiscard]] constexpr bool contains(const K key) const noexcept
+    {
+        return find_slot(key) != capacity;
+    }
+
+    [[nodiscard]] static constexpr size_t size() noexcept { return N; }
+
+    // The longest distance of a key from its home slot.
+    [[nodiscard]] constexpr size_t max_probe() const noexcept { return m_max_probe; }
+
+private:
+    [[nodiscard]] static constexpr size_t home(const K key) noexcept
+    {
+        return details::fibonacci_hash(Hash{}(key), shift);
+    }
+
+    [[nodiscard]] static constexpr size_t next(const size_t slot) noexcept
+    {
+        return (slot + 1) & (capacity - 1);
+    }
+
+    // Returns capacity if key is not present.
+    [[nodiscard]] constexpr size_t find_slot(const K key) const noexcept
+    {
+        DZE_OPTIONAL_CHECK(key != empty_key);
+
+        // The keys are distinct, so at most one slot matches and the loop need not stop early.
+        size_t result = capacity;
+        size_t slot = home(key);
+        for (size_t probe = 0; probe <= m_max_probe; ++probe, slot = next(slot))
+            result = m_keys[slot] == key ? slot : result;
+
+        return result;
+    }
+
+    K m_keys[capacity];
+    V m_values[capacity];
+    size_t m_max_probe = 0;
+};
+
+// Builds a frozen_map, e.g.
+//     constexpr auto names = dze::make_frozen_map<int, std::string_view, -1>({
+//         {1, "one"},
+//         {2, "two"}});
+template <
+    typename K,
+    typename V,
+    auto EmptyKey,
+    typename Hash = details::frozen_map_ns::integer_hash,
+    size_t N>
+[[nodiscard]] constexpr frozen_map<K, V, N, EmptyKey, Hash> make_frozen_map(
+    const std::pair<K, V> (&entries)[N])
+{
+    return frozen_map<K, V, N, EmptyKey, Hash>{entries};
+}
+
+} // namespace dze
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__AVX2__) || defined(__AVX512F__) || \
+    (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#include <immintrin.h>
+#endif
+
+#include "optional.hpp"
+#include "sentinel.hpp"
+
+namespace dze {
+
+namespace details::gather_ns {
+
+// How many elements ahead of the current one the scalar loop prefetches table entries for.
+constexpr size_t prefetch_distance = 16;
+
+inline void prefetch(const void* const address) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    static_cast<void>(address);
+#endif
+}
+
+template <typename Idx, typename IdxPolicy, typename T, typename Policy>
+void gather_scalar(
+    const optional<Idx, IdxPolicy>* const idx,
+    const size_t size,
+    const T* const table,
+    optional<T, Policy>* const out)
+{
+    const auto gather_one = [&](const size_t i) {
+        if (idx[i])
+            out[i] = table[*idx[i]];
+        else
+            out[i].reset();
+    };
+
+    size_t i = 0;
+    for (; i + prefetch_distance < size; ++i)
+    {
+        // Disengaged indices prefetch the first entry, which keeps the loop free of branches.
+        const auto& ahead = idx[i + prefetch_distance];
+        prefetch(table + (ahead ? *ahead : Idx{}));
+        gather_one(i);
+    }
+    for (; i < size; ++i)
+        gather_one(i);
+}
+
+// Object representation of a disengaged optional as an unsigned integer.
+template <typename T, typename Policy>
+[[nodiscard]] auto null_bits() noexcept
+{
+    using bits_type = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+
+    const optional<T, Policy> null;
+    bits_type bits;
+    std::memcpy(&bits, &null, sizeof(bits));
+    return bits;
+}
+
+// The vectorized paths load the indices and store the results as plain integers. That requires
+// optionals that are indistinguishable from their contained values, with a single known null
+// representation for the indices.
+template <typename Idx, typename IdxPolicy, typename T, typename Policy>
+constexpr bool use_simd_v =
+    std::is_integral_v<Idx> &&
+    sizeof(Idx) == 4 &&
+    optional_ns::is_sentinel_value_policy_v<IdxPolicy> &&
+    sizeof(optional<Idx, IdxPolicy>) == sizeof(Idx) &&
+    std::is_trivially_copyable_v<T> &&
+    (sizeof(T) == 4 || sizeof(T) == 8) &&
+    !optional_ns::is_default_policy_v<Policy> &&
+    std::is_trivially_copyable_v<optional<T, Policy>> &&
+    sizeof(optional<T, Policy>) == sizeof(T);
+
+#if defined(__AVX512F__)
+
+// Gathers whole vectors of 16 elements and returns how many elements were processed.
+// Disengaged lanes are masked off, so they never touch the table and keep the null value.
+template <typename Idx, typename IdxPolicy, typename T, typename Policy>
+size_t gather_simd(
+    const optional<Idx, IdxPolicy>* const idx,
+    const size_t size,
+    const T* const table,
+    optional<T, Policy>* const out)
+{
+    constexpr size_t width = 16;
+
+    const auto null_index = _mm512_set1_epi32(static_cast<int>(null_bits<Idx, IdxPolicy>()));
+    const auto sign = _mm512_set1_epi32(INT32_MIN);
+
+    size_t i = 0;
+    for (; i + width <= size; i += width)
+    {
+        const auto indices = _mm512_loadu_si512(static_cast<const void*>(idx + i));
+        const auto engaged = _mm512_cmpneq_epi32_mask(indices, null_index);
+        // Gather instructions take signed offsets.
+        if (std::is_unsigned_v<Idx> && _mm512_mask_test_epi32_mask(engaged, indices, sign) != 0)
+        {
+            gather_scalar(idx + i, width, table, out + i);
+            continue;
+        }
+
+        if constexpr (sizeof(T) == 4)
+        {
+            const auto nulls = _mm512_set1_epi32(static_cast<int>(null_bits<T, Policy>()));
+            const auto values = _mm512_mask_i32gather_epi32(nulls, engaged, indices, table, 4);
+            _mm512_storeu_si512(static_cast<void*>(out + i), values);
+        }
+        else
+        {
+            const auto nulls =
+                _mm512_set1_epi64(static_cast<long long>(null_bits<T, Policy>()));
+            const auto low = _mm512_mask_i32gather_epi64(
+                nulls,
+                static_cast<__mmask8>(engaged),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i)),
+                table,
+                8);
+            const auto high = _mm512_mask_i32gather_epi64(
+                nulls,
+                static_cast<__mmask8>(engaged >> 8),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i + 8)),
+                table,
+                8);
+            _mm512_storeu_si512(static_cast<void*>(out + i), low);
+            _mm512_storeu_si512(static_cast<void*>(out + i + 8), high);
+        }
+    }
+
+    return i;
+}
+
+#elif defined(__AVX2__)
+
+// Gathers whole vectors of 8 elements and returns how many elements were processed.
+// Disengaged lanes are masked off, so they never touch the table and keep the null value.
+template <typename Idx, typename IdxPolicy, typename T, typename Policy>
+size_t gather_simd(
+    const optional<Idx, IdxPolicy>* const idx,
+    const size_t size,
+    const T* const table,
+    optional<T, Policy>* const out)
+{
+    constexpr size_t width = 8;
+
+    const auto null_index = _mm256_set1_epi32(static_cast<int>(null_bits<Idx, IdxPolicy>()));
+    const auto ones = _mm256_set1_epi32(-1);
+
+    size_t i = 0;
+    for (; i + width <= size; i += width)
+    {
+        const auto indices =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx + i));
+        const auto engaged =
+            _mm256_xor_si256(_mm256_cmpeq_epi32(indices, null_index), ones);
+        // Gather instructions take signed offsets.
+        if (std::is_unsigned_v<Idx> &&
+            _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(engaged, indices))) != 0)
+        {
+            gather_scalar(idx + i, width, table, out + i);
+            continue;
+        }
+
+        if constexpr (sizeof(T) == 4)
+        {
+            const auto nulls = _mm256_set1_epi32(static_cast<int>(null_bits<T, Policy>()));
+            const auto values = _mm256_mask_i32gather_epi32(
+                nulls, reinterpret_cast<const int*>(table), indices, engaged, 4);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+        }
+        else
+        {
+            const auto nulls =
+                _mm256_set1_epi64x(static_cast<long long>(null_bits<T, Policy>()));
+            const auto base = reinterpret_cast<const long long*>(table);
+            const auto low = _mm256_mask_i32gather_epi64(
+                nulls,
+                base,
+                _mm256_castsi256_si128(indices),
+                _mm256_cvtepi32_epi64(_mm256_castsi256_si128(engaged)),
+                8);
+            const auto high = _mm256_mask_i32gather_epi64(
+                nulls,
+                base,
+                _mm256_extracti128_si256(indices, 1),
+                _mm256_cvtepi32_epi64(_mm256_extracti128_si256(engaged, 1)),
+                8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), low);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 4), high);
+        }
+    }
+
+    return i;
+}
+
+#endif
+
+} // namespace details::gather_ns
+
+// Materializes table[*idx] for each index in [idx_first, idx_last) into out, and a null for
+// each disengaged index. Every engaged index must be a valid position in table and out must
+// have room for idx_last - idx_first elements.
+//
+// With AVX2 or AVX-512 enabled at compile time, 32-bit sentinel indices into tables of 4 or 8
+// byte values are gathered with masked gather instructions, so disengaged lanes do not touch
+// memory. Other combinations use a scalar loop that prefetches the table entries ahead.
+template <typename Idx, typename IdxPolicy, typename T, typename Policy>
+void gather_optional(
+    const optional<Idx, IdxPolicy>* const idx_first,
+    const optional<Idx, IdxPolicy>* const idx_last,
+    const T* const table,
+    optional<T, Policy>* const out)
+{
+    const auto size = static_cast<size_t>(idx_last - idx_first);
+    size_t done = 0;
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+    if constexpr (details::gather_ns::use_simd_v<Idx, IdxPolicy, T, Policy>)
+        done = details::gather_ns::gather_simd(idx_first, size, table, out);
+#endif
+
+    details::gather_ns::gather_scalar(idx_first + done, size - done, table, out + done);
+}
+
+} // namespace dze
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace dze {
+
+// An optional that is engaged on first access with the result of an initializer, which
+// replaces a dze::optional member that is filled behind std::call_once or a mutex. One atomic
+// state serves as both the engagement flag and the once flag, so that an access after
+// initialization is a single acquire load.
+//
+// The first callers of value() race to run the initializer. One of them runs it while the
+// others block until it finishes. If the initializer throws, the exception propagates to that
+// caller and one of the blocked callers tries again.
+template <typename T, typename F>
+class lazy_optional
+{
+    static_assert(!std::is_reference_v<T>);
+    static_assert(std::is_invocable_r_v<T, F&>);
+
+    enum class state : uint8_t
+    {
+        empty,
+        busy,
+        ready
+    };
+
+public:
+    using value_type = T;
+
+    explicit lazy_optional(F init) noexcept(std::is_nothrow_move_constructible_v<F>)
+        : m_init{std::move(init)} {}
+
+    lazy_optional(const lazy_optional&) = delete;
+    lazy_optional& operator=(const lazy_optional&) = delete;
+
+    ~lazy_optional() { destroy(); }
+
+    [[nodiscard]] const T& value() const
+    {
+        if (m_state.load(std::memory_order_acquire) != state::ready)
+            initialize();
+
+        return get();
+    }
+
+    const T& operator*() const { return value(); }
+
+    const T* operator->() const { return std::addressof(value()); }
+
+    // Whether the value has been computed. Does not compute it.
+    [[nodiscard]] bool has_value() const noexcept
+    {
+        return m_state.load(std::memory_order_acquire) == state::ready;
+    }
+
+    // The value if it has been computed, or nullptr. Does not compute it.
+    [[nodiscard]] const T* get_if() const noexcept
+    {
+        return has_value() ? std::addressof(get()) : nullptr;
+    }
+
+    // Destroys the value, so that the next access computes it again. Unlike the other
+    // operations, this must not run concurrently with any access.
+    void invalidate() noexcept
+    {
+        destroy();
+        m_state.store(state::empty, std::memory_order_release);
+    }
+
+private:
+    [[nodiscard]] const T& get() const noexcept
+    {
+        return *std::launder(reinterpret_cast<const T*>(m_storage));
+    }
+
+    void initialize() const
+    {
+        for (;;)
+        {
+            auto current = state::empty;
+            if (m_state.compare_exchange_strong(
+                    current, state::busy, std::memory_order_acquire))
+                break;
+
+            if (current == state::ready)
+                return;
+
+            wait_while_busy();
+        }
+
+        struct guard
+        {
+            const lazy_optional* self;
+
+            ~guard()
+            {
+                if (self)
+                    self->publish(state::empty);
+            }
+        } g{this};
+
+        ::new (static_cast<void*>(m_storage)) T(std::invoke(m_init));
+        g.self = nullptr;
+        publish(state::ready);
+    }
+
+    void publish(const state s) const noexcept
+    {
+        m_state.store(s, std::memory_order_release);
+#if defined(__cpp_lib_atomic_wait)
+        m_state.notify_all();
+#endif
+    }
+
+    void wait_while_busy() const noexcept
+    {
+#if defined(__cpp_lib_atomic_wait)
+        m_state.wait(state::busy, std::memory_order_acquire);
+#else
+        while (m_state.load(std::memory_order_acquire) == state::busy)
+            std::this_thread::yield();
+#endif
+    }
+
+    void destroy() noexcept
+    {
+        if (m_state.load(std::memory_order_relaxed) == state::ready)
+            std::launder(reinterpret_cast<T*>(m_storage))->~T();
+    }
+
+    mutable F m_init;
+    mutable std::atomic<state> m_state{state::empty};
+    alignas(T) mutable std::byte m_storage[sizeof(T)];
+};
+
+template <typename F>
+lazy_optional(F) -> lazy_optional<std::remove_cv_t<std::invoke_result_t<F&>>, F>;
+
+} // namespace dze
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <dze/requires.hpp>
+
+#include "details/bit.hpp"
+#include "details/check.hpp"
+#include "optional.hpp"
+#include "sentinel.hpp"
+
+namespace dze {
+
+// A fixed-size lossy cache for memoizing pure functions. Each key maps to a set of Ways slots,
+// which are all probed on a lookup, and inserting into a full set overwrites one of its
+// entries. With one way, the cache is direct-mapped and a lookup is a hash and a comparison.
+//
+// The keys of a set are sentinel optionals stored together at the start of a cache line, with
+// their values after them, so a slot holding the empty key is free. The cache allocates only
+// on construction.
+//
+// A cache is not thread-safe; for a cache per thread, declare it thread_local. The hit and
+// miss counters may be read from any thread.
+template <
+    typename K,
+    typename V,
+    auto EmptyKey,
+    size_t Ways = 1,
+    typename Hash = hash<sentinel<K, EmptyKey>>>
+class memo_cache
+{
+    static_assert(std::is_integral_v<K> || std::is_enum_v<K>);
+    static_assert(Ways != 0 && (Ways & (Ways - 1)) == 0);
+
+    using key_type = sentinel<K, EmptyKey>;
+
+    static constexpr K empty_key{EmptyKey};
+
+    struct alignas(64) set
+    {
+        key_type keys[Ways];
+        // The value of a slot is constructed when its key is engaged.
+        struct
+        {
+            alignas(V) std::byte bytes[sizeof(V)];
+        } values[Ways];
+
+        [[nodiscard]] V& value(const size_t way) noexcept
+        {
+            return *std::launder(reinterpret_cast<V*>(values[way].bytes));
+        }
+    };
+
+public:
+    using value_type = V;
+
+    static constexpr size_t ways = Ways;
+
+    // The number of slots is rounded up to a power of two of at least Ways.
+    explicit memo_cache(const size_t capacity)
+        : m_mask{round_up(capacity) / Ways - 1}
+        // Shifting by 64 is undefined, and the mask selects the only set anyway.
+        , m_shift{m_mask == 0 ? 63 : 64 - details::popcount(m_mask)}
+        , m_sets{std::make_unique<set[]>(m_mask + 1)} {}
+
+    memo_cache(const memo_cache&) = delete;
+    memo_cache& operator=(const memo_cache&) = delete;
+
+    ~memo_cache() { clear(); }
+
+    // The value of key, or nullptr if it is not cached. The value stays valid until the next
+    // insertion. Counts a hit or a miss.
+    [[nodiscard]] const V* find(const K key) noexcept
+    {
+        DZE_OPTIONAL_CHECK(key != empty_key);
+
+        set& s = set_of(key);
+        for (size_t way = 0; way != Ways; ++way)
+        {
+            if (details::optional_ns::access::representation(s.keys[way]) == key)
+            {
+                count(m_hits);
+                return std::addressof(s.value(way));
+            }
+        }
+
+        count(m_misses);
+        return nullptr;
+    }
+
+    // Returns the cached value of key, or caches and returns f(key).
+    template <typename F>
+    const V& get_or_compute(const K key, F&& f)
+    {
+        if (const V* const cached = find(key))
+            return *cached;
+
+        return emplace(key, std::invoke(std::forward<F>(f), key));
+    }
+
+    // Caches a value for key, overwriting the previous value of key or, if its set is full,
+    // the value of another key. key must not be the empty key.
+    template <typename... Args,
+        DZE_REQUIRES(std::is_constructible_v<V, Args&&...>)>
+    const V& emplace(const K key, Args&&... args)
+    {
+        DZE_OPTIONAL_CHECK(key != empty_key);
+
+        set& s = set_of(key);
+        const size_t way = pick_way(s, key);
+        if (s.keys[way])
+        {
+            // Freed first, so that the slot stays empty if the constructor throws.
+            s.keys[way].reset();
+            s.value(way).~V();
+        }
+
+        ::new (static_cast<void*>(s.values[way].bytes)) V(std::forward<Args>(args)...);
+        s.keys[way] = key;
+        return s.value(way);
+    }
+
+    void clear() noexcept
+    {
+        for (size_t i = 0; i <= m_mask; ++i)
+        {
+            set& s = m_sets[i];
+            for (size_t way = 0; way != Ways; ++way)
+            {
+                if (s.keys[way])
+                {
+                    s.keys[way].reset();
+                    s.value(way).~V();
+                }
+            }
+        }
+    }
+
+    // Number of slots.
+    [[nodiscard]] size_t capacity() const noexcept { return (m_mask + 1) * Ways; }
+
+    [[nodiscard]] uint64_t hits() const noexcept
+    {
+        return m_hits.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t misses() const noexcept
+    {
+        return m_misses.load(std::memory_order_relaxed);
+    }
+
+    void reset_counters() noexcept
+    {
+        m_hits.store(0, std::memory_order_relaxed);
+        m_misses.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    [[nodiscard]] static size_t round_up(const size_t capacity) noexcept
+    {
+        size_t result = Ways;
+        while (result < capacity)
+            result *= 2;
+
+        return result;
+    }
+
+    // Only the owning thread writes the counters, so they need no read-modify-write.
+    static void count(std::atomic<uint64_t>& counter) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] set& set_of(const K key) noexcept
+    {
+        return m_sets[details::fibonacci_hash(Hash{}(key_type{key}), m_shift) & m_mask];
+    }
+
+    // The way that holds key, else a free way, else the way to overwrite, which rotates.
+    [[nodiscard]] size_t pick_way(const set& s, const K key) noexcept
+    {
+        size_t free = Ways;
+        for (size_t way = 0; way != Ways; ++way)
+        {
+            const K k = details::optional_ns::access::representation(s.keys[way]);
+            if (k == key)
+                return way;
+
+            if (k == empty_key && free == Ways)
+                free = way;
+        }
+
+        return free != Ways ? free : m_victim++ % Ways;
+    }
+
+    const size_t m_mask;
+    const unsigned m_shift;
+    const std::unique_ptr<set[]> m_sets;
+    size_t m_victim = 0;
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+};
+
+} // namespace dze
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <initializer_list>
 #include <type_traits>
+#if __has_include(<compare>)
+#include <compare>
+#endif
+#include <functional>
 #include <utility>
 
 #include <dze/type_traits.hpp>
@@ -9,6 +14,7 @@
 #include "bad_optional_access.hpp"
 #include "details/payload.hpp"
 #include "nullopt.hpp"
+#include "relocate.hpp"
 
 namespace dze {
 
@@ -20,6 +26,7 @@ template <typename T, typename Policy, typename Base>
 class base_impl
 {
     using stored_type = std::remove_const_t<T>;
+    using payload_type = payload<T, Policy>;
 
 protected:
     // construct has !is_engaged() as a precondition.
@@ -33,6 +40,17 @@ protected:
             payload.set();
     }
 
+    // construct_with has !is_engaged() as a precondition.
+    template <typename F>
+    void construct_with(F&& f)
+        noexcept(noexcept(std::declval<payload_type&>().construct_with(std::declval<F>())))
+    {
+        auto& payload = static_cast<Base*>(this)->get_payload();
+        payload.construct_with(std::forward<F>(f));
+        if constexpr (is_default_policy_v<Policy>)
+            payload.set();
+    }
+
     // destruct has is_engaged() as a precondition.
     void destruct() noexcept { static_cast<Base*>(this)->get_payload().destruct(); }
 
@@ -262,6 +280,30 @@ constexpr bool assignable_from_optional =
     std::is_assignable_v<T&, const optional<U, Policy>&&> ||
     std::is_assignable_v<T&, optional<U, Policy>&&>;
 
+template <typename T, typename F, typename = void>
+constexpr bool constructible_from_result_v = false;
+
+// A prvalue of the same type initializes the value directly, even if it is immovable.
+template <typename T, typename F>
+constexpr bool constructible_from_result_v<T, F, std::enable_if_t<std::is_invocable_v<F>>> =
+    std::is_same_v<std::remove_cv_t<std::invoke_result_t<F>>, std::remove_cv_t<T>> ||
+    std::is_constructible_v<T, std::invoke_result_t<F>>;
+
+template <typename T, typename... Args>
+constexpr bool assignable_from_single_v = false;
+
+template <typename T, typename U>
+constexpr bool assignable_from_single_v<T, U> = std::is_assignable_v<T&, U>;
+
+// Grants the non-member functions of this library access to the internals of optional.
+struct access;
+
+template <typename T>
+constexpr bool is_optional_v = false;
+
+template <typename T, typename Policy>
+constexpr bool is_optional_v<optional<T, Policy>> = true;
+
 } // namespace details::optional_ns
 
 template <typename T, typename Policy = details::optional_ns::default_policy>
@@ -280,8 +322,13 @@ class optional
 
     using base = details::optional_ns::base<T, Policy>;
 
+    static constexpr bool relocatable = !std::is_const_v<T> && is_trivially_relocatable_v<T>;
+
+    friend struct details::optional_ns::access;
+
 public:
     using value_type = T;
+    using policy_type = Policy;
 
     constexpr optional() = default;
 
@@ -438,7 +485,7 @@ public:
         DZE_REQUIRES(std::is_constructible_v<T, Args&&...>)>
     T& emplace(Args&&... args)
     {
-        this->destruct();
+        this->reset_impl();
         this->construct(std::forward<Args>(args)...);
         return this->get();
     }
@@ -447,20 +494,153 @@ public:
         DZE_REQUIRES(std::is_constructible_v<T, std::initializer_list<U>, Args&&...>)>
     T& emplace(std::initializer_list<U> ilist, Args&&... args)
     {
-        this->destruct();
+        this->reset_impl();
         this->construct(ilist, std::forward<Args>(args)...);
         return this->get();
     }
 
+    // Constructs the contained value from the prvalue returned by f() without moving it, which
+    // also works for immovable types.
+    template <typename F,
+        DZE_REQUIRES(details::optional_ns::constructible_from_result_v<T, F&&>)>
+    T& emplace_with(F&& f)
+    {
+        this->reset_impl();
+        this->construct_with(std::forward<F>(f));
+        return this->get();
+    }
+
+    // Assigns to the contained value if engaged and constructs it otherwise. Only a single
+    // argument is assigned directly, which lets the contained value keep resources such as
+    // the capacity of a std::vector. Multiple arguments are move assigned through a temporary,
+    // which replaces those resources with the temporary's.
+    template <typename... Args,
+        DZE_REQUIRES(std::is_constructible_v<T, Args&&...>)>
+    T& assign_or_emplace(Args&&... args)
+    {
+        if (this->is_engaged())
+        {
+            if constexpr (details::optional_ns::assignable_from_single_v<T, Args&&...>)
+            {
+                ((this->get() = std::forward<Args>(args)), ...);
+                return this->get();
+            }
+            else if constexpr (std::is_move_assignable_v<T>)
+            {
+                this->get() = T(std::forward<Args>(args)...);
+                return this->get();
+            }
+            else
+                this->unchecked_reset();
+        }
+
+        this->construct(std::forward<Args>(args)...);
+        return this->get();
+    }
+
+    // Lets fill(std::byte*) write the object representation of a trivially copyable value
+    // directly into the storage of this, e.g. with read() or memcpy(), and engages this
+    // afterwards. fill returns either nothing, a bool that is false on failure, or a byte
+    // count such as that of read(), which must be sizeof(T) for success. On failure, or if
+    // fill throws, this is left disengaged. Returns whether this is engaged, which is false
+    // also when the written bytes are the null representation of a non-default policy.
+    template <typename F, typename U = T,
+        DZE_REQUIRES(std::is_trivially_copyable_v<U> && std::is_invocable_v<F&&, std::byte*>)>
+    bool emplace_raw(F&& fill)
+    {
+        using result_type = std::invoke_result_t<F&&, std::byte*>;
+        static_assert(
+            std::is_void_v<result_type> ||
+                std::is_same_v<result_type, bool> ||
+                std::is_integral_v<result_type>,
+            "fill must return nothing, a bool or a byte count.");
+
+        auto& payload = this->get_payload();
+        if constexpr (details::optional_ns::is_default_policy_v<Policy>)
+            this->reset_impl();
+
+        std::byte* const storage = payload.raw_storage();
+
+        // Puts back the null representation that fill may have overwritten.
+        struct guard
+        {
+            std::byte* storage;
+
+            ~guard()
+            {
+                if constexpr (!details::optional_ns::is_default_policy_v<Policy>)
+                {
+                    if (storage)
+                        Policy::null_initialize(storage);
+                }
+            }
+        } g{storage};
+
+        bool filled = true;
+        if constexpr (std::is_void_v<result_type>)
+            std::invoke(std::forward<F>(fill), storage);
+        else if constexpr (std::is_same_v<result_type, bool>)
+            filled = std::invoke(std::forward<F>(fill), storage);
+        else
+        {
+            const auto bytes = std::invoke(std::forward<F>(fill), storage);
+            if constexpr (std::is_signed_v<result_type>)
+                filled = bytes >= 0 && static_cast<size_t>(bytes) == sizeof(T);
+            else
+                filled = static_cast<size_t>(bytes) == sizeof(T);
+        }
+
+        if (!filled)
+            return false;
+
+        g.storage = nullptr;
+        if constexpr (details::optional_ns::is_default_policy_v<Policy>)
+            payload.set();
+        return payload.is_engaged();
+    }
+
+    // Moves the contained value out and leaves this disengaged.
+    optional take() noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        optional result;
+        if (this->is_engaged())
+        {
+            result.construct(std::move(this->get()));
+            this->unchecked_reset();
+        }
+
+        return result;
+    }
+
+    // Replaces the contained value with one constructed from value and returns the previous
+    // state. The new value is constructed before it is swapped in, so this is unchanged if
+    // the construction throws. Nothing of the previous value is reused.
+    template <typename U = T,
+        DZE_REQUIRES(
+            std::is_constructible_v<T, U&&> &&
+            std::is_move_constructible_v<T> &&
+            std::is_swappable_v<T>)>
+    optional exchange(U&& value)
+    {
+        optional result{std::in_place, std::forward<U>(value)};
+        swap(result);
+        return result;
+    }
+
     // Destructor is implicit, implemented in optional_ns::base.
 
     void swap(optional& other)
-        noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_swappable_v<T>)
+        noexcept(
+            relocatable ||
+            (std::is_nothrow_move_constructible_v<T> && std::is_nothrow_swappable_v<T>))
     {
         using std::swap;
 
-        if (this->is_engaged() && other.is_engaged())
-            swap(this->get() && other.get());
+        // Swapping the representations also covers the mixed cases without branching.
+        if constexpr (relocatable)
+            relocate_swap(*this, other);
+        else if (this->is_engaged() && other.is_engaged())
+            swap(this->get(), other.get());
         else if (this->is_engaged())
         {
             other.construct(std::move(this->get()));
@@ -492,7 +672,7 @@ public:
     [[nodiscard]] constexpr T& value() &
     {
         if (!this->is_engaged())
-            throw bad_optional_access{};
+            details::bad_optional_access_failure();
 
         return this->get();
     }
@@ -500,7 +680,7 @@ public:
     [[nodiscard]] constexpr const T& value() const&
     {
         if (!this->is_engaged())
-            throw bad_optional_access{};
+            details::bad_optional_access_failure();
 
         return this->get();
     }
@@ -508,7 +688,7 @@ public:
     [[nodiscard]] constexpr T&& value() &&
     {
         if (!this->is_engaged())
-            throw bad_optional_access{};
+            details::bad_optional_access_failure();
 
         return std::move(this->get());
     }
@@ -516,8 +696,25 @@ public:
     [[nodiscard]] constexpr const T&& value() const&&
     {
         if (!this->is_engaged())
-            throw bad_optional_access{};
+            details::bad_optional_access_failure();
+
+        return std::move(this->get());
+    }
+
+    // Like operator*, the value_unchecked() operations have has_value as a precondition, which
+    // is handled according to DZE_OPTIONAL_CHECK_LEVEL. They are for code that has already
+    // checked has_value and wants that spelled out.
+    [[nodiscard]] constexpr T& value_unchecked() & noexcept { return this->get(); }
+
+    [[nodiscard]] constexpr const T& value_unchecked() const& noexcept { return this->get(); }
+
+    [[nodiscard]] constexpr T&& value_unchecked() && noexcept
+    {
+        return std::move(this->get());
+    }
 
+    [[nodiscard]] constexpr const T&& value_unchecked() const&& noexcept
+    {
         return std::move(this->get());
     }
 
@@ -549,12 +746,79 @@ public:
 template <typename T>
 optional(T) -> optional<T>;
 
+// Lets fill(std::byte*, size_t) write the object representations of the values of
+// [first, last) in one go, e.g. with a single read() into the whole range. This requires
+// optionals that are indistinguishable from their values, so that an element whose bytes are
+// the null representation of the policy reads as disengaged. Returns what fill returns.
+template <typename T, typename Policy, typename F,
+    DZE_REQUIRES(
+        std::is_trivially_copyable_v<T> &&
+        !details::optional_ns::is_default_policy_v<Policy> &&
+        sizeof(optional<T, Policy>) == sizeof(T) &&
+        std::is_invocable_v<F&&, std::byte*, size_t>)>
+decltype(auto) emplace_raw(
+    optional<T, Policy>* const first, optional<T, Policy>* const last, F&& fill)
+{
+    return std::invoke(
+        std::forward<F>(fill),
+        reinterpret_cast<std::byte*>(first),
+        static_cast<size_t>(last - first) * sizeof(T));
+}
+
+// The policy is trivially copyable, so an optional is trivially relocatable when its value is.
+template <typename T, typename Policy>
+struct is_trivially_relocatable<optional<T, Policy>>
+    : is_trivially_relocatable<std::remove_const_t<T>> {};
+
+namespace details::optional_ns {
+
+struct access
+{
+    template <typename T, typename Policy>
+    [[nodiscard]] static constexpr const T& representation(
+        const optional<T, Policy>& opt) noexcept
+    {
+        return opt.get_payload().representation();
+    }
+
+    // Disengages opt without running the destructor of its value.
+    template <typename T, typename Policy>
+    static void release(optional<T, Policy>& opt) noexcept
+    {
+        if (opt)
+            opt.get_payload().unchecked_release();
+    }
+
+    // The storage of a disengaged optional of the default policy, which is unused until the
+    // optional is engaged and may hold other bytes meanwhile.
+    template <typename T>
+    [[nodiscard]] static std::byte* idle_storage(optional<T, default_policy>& opt) noexcept
+    {
+        DZE_OPTIONAL_CHECK(!opt);
+
+        return opt.get_payload().raw_storage();
+    }
+};
+
+// Optionals of the same type and policy whose null representation sorts first are compared
+// as plain values of the contained type without checking for engagement.
+template <typename T, typename Policy1, typename U, typename Policy2>
+constexpr bool compare_representations =
+    std::is_same_v<T, U> && std::is_same_v<Policy1, Policy2> && null_sorts_first_v<Policy1>;
+
+} // namespace details::optional_ns
+
 template <typename T, typename Policy1, typename U, typename Policy2,
     DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() == std::declval<U>()), bool>)>
 [[nodiscard]] constexpr bool operator==(
     const optional<T, Policy1>& lhs, const optional<U, Policy2>& rhs)
 {
-    return static_cast<bool>(lhs) == static_cast<bool>(rhs) && (!lhs || *lhs == *rhs);
+    using details::optional_ns::access;
+
+    if constexpr (details::optional_ns::compare_representations<T, Policy1, U, Policy2>)
+        return access::representation(lhs) == access::representation(rhs);
+    else
+        return static_cast<bool>(lhs) == static_cast<bool>(rhs) && (!lhs || *lhs == *rhs);
 }
 
 template <typename T, typename Policy1, typename U, typename Policy2,
@@ -562,9 +826,16 @@ template <typename T, typename Policy1, typename U, typename Policy2,
 [[nodiscard]] constexpr bool operator!=(
     const optional<T, Policy1>& lhs, const optional<U, Policy2>& rhs)
 {
-    return
-        static_cast<bool>(lhs) != static_cast<bool>(rhs) ||
-        (static_cast<bool>(lhs) && *lhs != *rhs);
+    using details::optional_ns::access;
+
+    if constexpr (details::optional_ns::compare_representations<T, Policy1, U, Policy2>)
+        return access::representation(lhs) != access::representation(rhs);
+    else
+    {
+        return
+            static_cast<bool>(lhs) != static_cast<bool>(rhs) ||
+            (static_cast<bool>(lhs) && *lhs != *rhs);
+    }
 }
 
 template <typename T, typename Policy1, typename U, typename Policy2,
@@ -572,7 +843,12 @@ template <typename T, typename Policy1, typename U, typename Policy2,
 [[nodiscard]] constexpr bool operator<(
     const optional<T, Policy1>& lhs, const optional<U, Policy2>& rhs)
 {
-    return static_cast<bool>(rhs) && (!lhs || *lhs < *rhs);
+    using details::optional_ns::access;
+
+    if constexpr (details::optional_ns::compare_representations<T, Policy1, U, Policy2>)
+        return access::representation(lhs) < access::representation(rhs);
+    else
+        return static_cast<bool>(rhs) && (!lhs || *lhs < *rhs);
 }
 
 template <typename T, typename Policy1, typename U, typename Policy2,
@@ -580,7 +856,12 @@ template <typename T, typename Policy1, typename U, typename Policy2,
 [[nodiscard]] constexpr bool operator>(
     const optional<T, Policy1>& lhs, const optional<U, Policy2>& rhs)
 {
-    return static_cast<bool>(lhs) && (!lhs || *lhs > *rhs);
+    using details::optional_ns::access;
+
+    if constexpr (details::optional_ns::compare_representations<T, Policy1, U, Policy2>)
+        return access::representation(lhs) > access::representation(rhs);
+    else
+        return static_cast<bool>(lhs) && (!rhs || *lhs > *rhs);
 }
 
 template <typename T, typename Policy1, typename U, typename Policy2,
@@ -588,7 +869,12 @@ template <typename T, typename Policy1, typename U, typename Policy2,
 [[nodiscard]] constexpr bool operator<=(
     const optional<T, Policy1>& lhs, const optional<U, Policy2>& rhs)
 {
-    return static_cast<bool>(rhs) && (!lhs || *lhs <= *rhs);
+    using details::optional_ns::access;
+
+    if constexpr (details::optional_ns::compare_representations<T, Policy1, U, Policy2>)
+        return access::representation(lhs) <= access::representation(rhs);
+    else
+        return !lhs || (static_cast<bool>(rhs) && *lhs <= *rhs);
 }
 
 template <typename T, typename Policy1, typename U, typename Policy2,
@@ -596,8 +882,37 @@ template <typename T, typename Policy1, typename U, typename Policy2,
 [[nodiscard]] constexpr bool operator>=(
     const optional<T, Policy1>& lhs, const optional<U, Policy2>& rhs)
 {
-    return static_cast<bool>(lhs) && (!lhs || *lhs >= *rhs);
+    using details::optional_ns::access;
+
+    if constexpr (details::optional_ns::compare_representations<T, Policy1, U, Policy2>)
+        return access::representation(lhs) >= access::representation(rhs);
+    else
+        return !rhs || (static_cast<bool>(lhs) && *lhs >= *rhs);
+}
+
+#ifdef __cpp_lib_three_way_comparison
+template <typename T, typename Policy1, typename U, typename Policy2,
+    DZE_REQUIRES(std::three_way_comparable_with<T, U>)>
+[[nodiscard]] constexpr std::compare_three_way_result_t<T, U> operator<=>(
+    const optional<T, Policy1>& lhs, const optional<U, Policy2>& rhs)
+{
+    using details::optional_ns::access;
+
+    if constexpr (details::optional_ns::compare_representations<T, Policy1, U, Policy2>)
+        return access::representation(lhs) <=> access::representation(rhs);
+    else if (lhs && rhs)
+        return *lhs <=> *rhs;
+    else
+        return static_cast<bool>(lhs) <=> static_cast<bool>(rhs);
+}
+
+template <typename T, typename Policy>
+[[nodiscard]] constexpr std::strong_ordering operator<=>(
+    const optional<T, Policy>& lhs, nullopt_t) noexcept
+{
+    return static_cast<bool>(lhs) <=> false;
 }
+#endif
 
 // Comparisons with nullopt.
 template <typename T, typename Policy>
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dze/requires.hpp>
+
+#include "bad_optional_access.hpp"
+#include "details/check.hpp"
+#include "nullopt.hpp"
+#include "optional.hpp"
+#include "optional_reference.hpp"
+#include "relocate.hpp"
+
+namespace dze {
+
+namespace details::optional_index_ns {
+
+// Whether the elements of Container are the Ts at consecutive addresses, so that the index of
+// an element is its distance from the first, e.g. std::vector<T>, std::array<T, N> or T*.
+template <typename Container, typename T, typename = void>
+constexpr bool contiguous_v =
+    std::is_pointer_v<Container> &&
+    std::is_same_v<std::remove_cv_t<std::remove_pointer_t<Container>>, std::remove_cv_t<T>>;
+
+template <typename Container, typename T>
+constexpr bool contiguous_v<
+    Container,
+    T,
+    std::void_t<decltype(std::data(std::declval<const Container&>()))>> =
+    std::is_same_v<
+        std::remove_cv_t<
+            std::remove_pointer_t<decltype(std::data(std::declval<const Container&>()))>>,
+        std::remove_cv_t<T>>;
+
+} // namespace details::optional_index_ns
+
+// A 32-bit index of an element of a Container, with UINT32_MAX meaning disengaged. It refers
+// to an element like an optional_reference but is resolved against the container, which is
+// passed to the observers, so references into one arena take half the space of pointers and
+// stay valid when the arena is reallocated. Container is anything indexable with operator[],
+// e.g. std::vector<T>, std::deque<T> or T*, and only tags which base an index belongs to.
+// Finding the index of an element takes a contiguous container, e.g. not std::deque<T>.
+//
+// Like an optional_reference, assignment rebinds. Comparisons and hashing are those of the
+// indices, not of the elements, as with pointers.
+template <typename T, typename Container = std::vector<T>>
+class optional_index
+{
+public:
+    using index_type = uint32_t;
+    using container_type = Container;
+
+    static constexpr index_type null_index = UINT32_MAX;
+
+    constexpr optional_index() noexcept = default;
+
+    constexpr optional_index(nullopt_t) noexcept {}
+
+    explicit constexpr optional_index(const index_type index) noexcept
+        : m_index{index}
+    {
+        DZE_OPTIONAL_CHECK(index != null_index);
+    }
+
+    // The index of element, which must be an element of base.
+    template <typename C = Container,
+        DZE_REQUIRES(details::optional_index_ns::contiguous_v<C, T>)>
+    constexpr optional_index(const Container& base, const T& element) noexcept
+        : optional_index{index_of(base, element)} {}
+
+    constexpr optional_index& operator=(nullopt_t) noexcept
+    {
+        m_index = null_index;
+        return *this;
+    }
+
+    constexpr optional_index& emplace(const index_type index) noexcept
+    {
+        return *this = optional_index{index};
+    }
+
+    template <typename C = Container,
+        DZE_REQUIRES(details::optional_index_ns::contiguous_v<C, T>)>
+    constexpr optional_index& emplace(const Container& base, const T& element) noexcept
+    {
+        return *this = optional_index{base, element};
+    }
+
+    constexpr void reset() noexcept { m_index = null_index; }
+
+    constexpr void swap(optional_index& other) noexcept
+    {
+        const auto backup = m_index;
+        m_index = other.m_index;
+        other.m_index = backup;
+    }
+
+    [[nodiscard]] constexpr bool has_value() const noexcept { return m_index != null_index; }
+
+    explicit constexpr operator bool() const noexcept { return has_value(); }
+
+    [[nodiscard]] constexpr index_type index() const noexcept
+    {
+        DZE_OPTIONAL_CHECK(has_value());
+
+        return m_index;
+    }
+
+    // null_index if disengaged.
+    [[nodiscard]] constexpr index_type raw_index() const noexcept { return m_index; }
+
+    // The element in base, or nullopt.
+    template <typename Base,
+        DZE_REQUIRES(std::is_same_v<std::remove_const_t<Base>, Container>)>
+    [[nodiscard]] constexpr auto resolve(Base& base) const noexcept
+    {
+        using element = std::remove_reference_t<decltype(base[m_index])>;
+        return has_value() ? optional_reference<element>{base[m_index]}
+                           : optional_reference<element>{};
+    }
+
+    template <typename Base,
+        DZE_REQUIRES(std::is_same_v<std::remove_const_t<Base>, Container>)>
+    [[nodiscard]] constexpr decltype(auto) value(Base& base) const
+    {
+        if (!has_value())
+            details::bad_optional_access_failure();
+
+        return base[m_index];
+    }
+
+    template <typename Base,
+        DZE_REQUIRES(std::is_same_v<std::remove_const_t<Base>, Container>)>
+    [[nodiscard]] constexpr decltype(auto) value_unchecked(Base& base) const noexcept
+    {
+        return base[index()];
+    }
+
+    template <typename Base, typename U,
+        DZE_REQUIRES(std::is_same_v<std::remove_const_t<Base>, Container>)>
+    [[nodiscard]] constexpr T value_or(Base& base, U&& u) const
+    {
+        static_assert(std::is_copy_constructible_v<T>);
+        static_assert(std::is_convertible_v<U&&, T>);
+
+        return has_value() ? static_cast<T>(base[m_index])
+                           : static_cast<T>(std::forward<U>(u));
+    }
+
+private:
+    [[nodiscard]] static constexpr index_type index_of(
+        const Container& base, const T& element) noexcept
+    {
+        const T* first;
+        if constexpr (std::is_pointer_v<Container>)
+            first = base;
+        else
+            first = std::data(base);
+
+        const auto offset = std::addressof(element) - first;
+        DZE_OPTIONAL_CHECK(offset >= 0 && offset < std::ptrdiff_t{null_index});
+
+        return static_cast<index_type>(offset);
+    }
+
+    index_type m_index = null_index;
+};
+
+template <typename T, typename Container>
+struct is_trivially_relocatable<optional_index<T, Container>> : std::true_type {};
+
+namespace details::optional_index_ns {
+
+// Orders disengaged indices before all others, as optionals are ordered.
+template <typename T, typename Container>
+[[nodiscard]] constexpr uint32_t key(const optional_index<T, Container>& opt) noexcept
+{
+    return opt.raw_index() + 1;
+}
+
+} // namespace details::optional_index_ns
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator==(
+    const optional_index<T, Container>& lhs, const optional_index<T, Container>& rhs) noexcept
+{
+    return lhs.raw_index() == rhs.raw_index();
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator!=(
+    const optional_index<T, Container>& lhs, const optional_index<T, Container>& rhs) noexcept
+{
+    return lhs.raw_index() != rhs.raw_index();
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator<(
+    const optional_index<T, Container>& lhs, const optional_index<T, Container>& rhs) noexcept
+{
+    return details::optional_index_ns::key(lhs) < details::optional_index_ns::key(rhs);
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator>(
+    const optional_index<T, Container>& lhs, const optional_index<T, Container>& rhs) noexcept
+{
+    return details::optional_index_ns::key(lhs) > details::optional_index_ns::key(rhs);
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator<=(
+    const optional_index<T, Container>& lhs, const optional_index<T, Container>& rhs) noexcept
+{
+    return details::optional_index_ns::key(lhs) <= details::optional_index_ns::key(rhs);
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator>=(
+    const optional_index<T, Container>& lhs, const optional_index<T, Container>& rhs) noexcept
+{
+    return details::optional_index_ns::key(lhs) >= details::optional_index_ns::key(rhs);
+}
+
+// Comparisons with nullopt.
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator==(
+    const optional_index<T, Container>& lhs, nullopt_t) noexcept
+{
+    return !lhs;
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator==(
+    nullopt_t, const optional_index<T, Container>& rhs) noexcept
+{
+    return !rhs;
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator!=(
+    const optional_index<T, Container>& lhs, nullopt_t) noexcept
+{
+    return static_cast<bool>(lhs);
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator!=(
+    nullopt_t, const optional_index<T, Container>& rhs) noexcept
+{
+    return static_cast<bool>(rhs);
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator<(const optional_index<T, Container>&, nullopt_t) noexcept
+{
+    return false;
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator<(
+    nullopt_t, const optional_index<T, Container>& rhs) noexcept
+{
+    return static_cast<bool>(rhs);
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator>(
+    const optional_index<T, Container>& lhs, nullopt_t) noexcept
+{
+    return static_cast<bool>(lhs);
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator>(nullopt_t, const optional_index<T, Container>&) noexcept
+{
+    return false;
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator<=(
+    const optional_index<T, Container>& lhs, nullopt_t) noexcept
+{
+    return !lhs;
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator<=(
+    nullopt_t, const optional_index<T, Container>&) noexcept
+{
+    return true;
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator>=(
+    const optional_index<T, Container>&, nullopt_t) noexcept
+{
+    return true;
+}
+
+template <typename T, typename Container>
+[[nodiscard]] constexpr bool operator>=(
+    nullopt_t, const optional_index<T, Container>& rhs) noexcept
+{
+    return !rhs;
+}
+
+template <typename T, typename Container>
+constexpr void swap(
+    optional_index<T, Container>& lhs, optional_index<T, Container>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+// Hashes like a dze::optional of the index.
+template <typename T, typename Container>
+struct hash<optional_index<T, Container>>
+{
+    size_t operator()(const optional_index<T, Container>& opt) const
+    {
+        constexpr auto magic_disengaged_hash = static_cast<size_t>(-3333);
+        return opt ? std::hash<uint32_t>{}(opt.index()) : magic_disengaged_hash;
+    }
+};
+
+} // namespace dze
@@ -7,7 +7,9 @@
 #include <dze/requires.hpp>
 
 #include "bad_optional_access.hpp"
+#include "details/check.hpp"
 #include "nullopt.hpp"
+#include "relocate.hpp"
 
 namespace dze {
 
@@ -110,12 +112,17 @@ public:
     {
         const auto backup = m_ref;
         m_ref = other.m_ref;
-        other.mptr = backup;
+        other.m_ref = backup;
     }
 
-    constexpr T* operator->() const noexcept { return m_ref; }
+    constexpr T* operator->() const noexcept
+    {
+        DZE_OPTIONAL_CHECK(m_ref);
+
+        return m_ref;
+    }
 
-    constexpr T& operator*() const noexcept { return *m_ref; }
+    constexpr T& operator*() const noexcept { return *operator->(); }
 
     [[nodiscard]] constexpr bool has_value() const noexcept { return m_ref != nullptr; }
 
@@ -124,11 +131,13 @@ public:
     [[nodiscard]] constexpr T& value() const
     {
         if (!has_value())
-            throw bad_optional_access{};
+            details::bad_optional_access_failure();
 
         return *m_ref;
     }
 
+    [[nodiscard]] constexpr T& value_unchecked() const noexcept { return **this; }
+
     template <typename U>
     [[nodiscard]] constexpr T value_or(U&& u) const
     {
@@ -145,6 +154,9 @@ private:
 template <typename T>
 optional_reference(T&) -> optional_reference<T>;
 
+template <typename T>
+struct is_trivially_relocatable<optional_reference<T>> : std::true_type {};
+
 template <typename T, typename U,
     DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() == std::declval<U>()), bool>)>
 [[nodiscard]] constexpr bool operator==(
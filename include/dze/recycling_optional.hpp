@@ -0,0 +1,330 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <dze/requires.hpp>
+
+#include "bad_optional_access.hpp"
+#include "details/check.hpp"
+#include "nullopt.hpp"
+#include "optional.hpp"
+
+namespace dze {
+
+namespace details::recycling_ns {
+
+template <typename T, typename = void, typename... Args>
+constexpr bool has_assign_v = false;
+
+template <typename T, typename... Args>
+constexpr bool has_assign_v<
+    T,
+    std::void_t<decltype(std::declval<T&>().assign(std::declval<Args>()...))>,
+    Args...> = true;
+
+template <typename Traits, typename T, typename = void, typename... Args>
+constexpr bool traits_assign_v = false;
+
+template <typename Traits, typename T, typename... Args>
+constexpr bool traits_assign_v<
+    Traits,
+    T,
+    std::void_t<decltype(Traits::assign(std::declval<T&>(), std::declval<Args>()...))>,
+    Args...> = true;
+
+} // namespace details::recycling_ns
+
+// Puts a value back into its empty state while keeping the resources it owns, e.g. the
+// capacity of a container. The default calls clear(). Specialize it for other types:
+//
+//   template <>
+//   struct dze::recycle_traits<my_buffer>
+//   {
+//       static void recycle(my_buffer& buffer) noexcept { buffer.rewind(); }
+//   };
+//
+// An optional assign(value, args...) gives value the state of T(args...) in place, which
+// lets emplace with several arguments keep the resources too. The default calls
+// value.assign(args...) where it exists, e.g. std::vector<T>::assign(count, value).
+template <typename T>
+struct recycle_traits
+{
+    static void recycle(T& value) noexcept(noexcept(value.clear())) { value.clear(); }
+
+    template <typename... Args,
+        DZE_REQUIRES(details::recycling_ns::has_assign_v<T, void, Args&&...>)>
+    static void assign(T& value, Args&&... args)
+    {
+        value.assign(std::forward<Args>(args)...);
+    }
+};
+
+// An optional whose recycle_reset() disengages without destroying the contained value.
+// The value is recycled instead and reused by the next emplace() or assignment, so that
+// repeatedly resetting and re-engaging does not free and reallocate its resources. That
+// holds for assignment, and for emplace with no argument, with one argument that T is
+// assignable from, or with arguments that recycle_traits<T>::assign accepts. Other emplace
+// calls assign a temporary, whose resources replace those of the recycled value. emplace
+// with no argument on an engaged optional recycles its value as well.
+// reset() and assigning nullopt destroy the value like they do for dze::optional.
+template <typename T>
+class recycling_optional
+{
+    static_assert(!std::is_const_v<T>);
+
+public:
+    using value_type = T;
+
+    recycling_optional() = default;
+
+    constexpr recycling_optional(nullopt_t) noexcept {}
+
+    template <typename U = T,
+        DZE_REQUIRES(
+            !std::is_same_v<recycling_optional, std::decay_t<U>> &&
+            !std::is_same_v<std::in_place_t, std::decay_t<U>> &&
+            std::is_constructible_v<T, U&&> &&
+            std::is_convertible_v<U&&, T>)>
+    recycling_optional(U&& value)
+        : m_value{std::in_place, std::forward<U>(value)}
+        , m_engaged{true} {}
+
+    template <typename U = T,
+        DZE_REQUIRES(
+            !std::is_same_v<recycling_optional, std::decay_t<U>> &&
+            !std::is_same_v<std::in_place_t, std::decay_t<U>> &&
+            std::is_constructible_v<T, U&&> &&
+            !std::is_convertible_v<U&&, T>)>
+    explicit recycling_optional(U&& value)
+        : m_value{std::in_place, std::forward<U>(value)}
+        , m_engaged{true} {}
+
+    template <typename... Args,
+        DZE_REQUIRES(std::is_constructible_v<T, Args&&...>)>
+    explicit recycling_optional(std::in_place_t, Args&&... args)
+        : m_value{std::in_place, std::forward<Args>(args)...}
+        , m_engaged{true} {}
+
+    recycling_optional(const recycling_optional& other)
+    {
+        if (other)
+            emplace(*other);
+    }
+
+    // The recycled value of other is moved along.
+    recycling_optional(recycling_optional&& other) = default;
+
+    // Assignment reuses the recycled value of this.
+    recycling_optional& operator=(const recycling_optional& other)
+    {
+        if (other)
+            emplace(*other);
+        else
+            recycle_reset();
+
+        return *this;
+    }
+
+    recycling_optional& operator=(recycling_optional&& other)
+        noexcept(std::is_nothrow_move_assignable_v<optional<T>>)
+    {
+        m_value = std::move(other.m_value);
+        m_engaged = other.m_engaged;
+        return *this;
+    }
+
+    recycling_optional& operator=(nullopt_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    template <typename U = T,
+        DZE_REQUIRES(
+            !std::is_same_v<recycling_optional, std::decay_t<U>> &&
+            std::is_constructible_v<T, U&&>)>
+    recycling_optional& operator=(U&& value)
+    {
+        emplace(std::forward<U>(value));
+        return *this;
+    }
+
+    // Engages this with a value constructed from args. Without arguments, an engaged value is
+    // recycled and a recycled one is reused as is. Otherwise, the value is assigned to.
+    template <typename... Args,
+        DZE_REQUIRES(std::is_constructible_v<T, Args&&...>)>
+    T& emplace(Args&&... args)
+    {
+        using traits = recycle_traits<T>;
+
+        if constexpr (sizeof...(Args) == 0)
+        {
+            if (!m_value)
+                m_value.emplace();
+            else if (m_engaged)
+                traits::recycle(*m_value);
+        }
+        else if constexpr (
+            sizeof...(Args) > 1 &&
+            details::recycling_ns::traits_assign_v<traits, T, void, Args&&...>)
+        {
+            if (m_value)
+                traits::assign(*m_value, std::forward<Args>(args)...);
+            else
+                m_value.emplace(std::forward<Args>(args)...);
+        }
+        else
+            m_value.assign_or_emplace(std::forward<Args>(args)...);
+
+        m_engaged = true;
+        return *m_value;
+    }
+
+    // Disengages this and keeps the value for reuse.
+    void recycle_reset() noexcept(noexcept(recycle_traits<T>::recycle(std::declval<T&>())))
+    {
+        if (m_engaged)
+        {
+            recycle_traits<T>::recycle(*m_value);
+            m_engaged = false;
+        }
+    }
+
+    // Disengages this and destroys the value, including a recycled one.
+    void reset() noexcept
+    {
+        m_value.reset();
+        m_engaged = false;
+    }
+
+    void swap(recycling_optional& other)
+        noexcept(noexcept(std::declval<optional<T>&>().swap(std::declval<optional<T>&>())))
+    {
+        m_value.swap(other.m_value);
+        std::swap(m_engaged, other.m_engaged);
+    }
+
+    constexpr const T* operator->() const { return std::addressof(**this); }
+
+    constexpr T* operator->() { return std::addressof(**this); }
+
+    constexpr const T& operator*() const&
+    {
+        DZE_OPTIONAL_CHECK(m_engaged);
+
+        return *m_value;
+    }
+
+    constexpr T& operator*() &
+    {
+        DZE_OPTIONAL_CHECK(m_engaged);
+
+        return *m_value;
+    }
+
+    constexpr T&& operator*() &&
+    {
+        DZE_OPTIONAL_CHECK(m_engaged);
+
+        return *std::move(m_value);
+    }
+
+    explicit constexpr operator bool() const noexcept { return m_engaged; }
+
+    [[nodiscard]] constexpr bool has_value() const noexcept { return m_engaged; }
+
+    [[nodiscard]] constexpr T& value() &
+    {
+        if (!m_engaged)
+            details::bad_optional_access_failure();
+
+        return *m_value;
+    }
+
+    [[nodiscard]] constexpr const T& value() const&
+    {
+        if (!m_engaged)
+            details::bad_optional_access_failure();
+
+        return *m_value;
+    }
+
+    [[nodiscard]] constexpr T&& value() &&
+    {
+        if (!m_engaged)
+            details::bad_optional_access_failure();
+
+        return *std::move(m_value);
+    }
+
+    template <typename U>
+    [[nodiscard]] constexpr T value_or(U&& default_value) const&
+    {
+        static_assert(std::is_copy_constructible_v<T>);
+        static_assert(std::is_convertible_v<U&&, T>);
+
+        return m_engaged ? *m_value : static_cast<T>(std::forward<U>(default_value));
+    }
+
+private:
+    // Engaged whenever this is engaged, and also while holding a recycled value.
+    optional<T> m_value;
+    bool m_engaged = false;
+};
+
+template <typename T>
+recycling_optional(T) -> recycling_optional<T>;
+
+template <typename T, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() == std::declval<U>()), bool>)>
+[[nodiscard]] bool operator==(
+    const recycling_optional<T>& lhs, const recycling_optional<U>& rhs)
+{
+    return static_cast<bool>(lhs) == static_cast<bool>(rhs) && (!lhs || *lhs == *rhs);
+}
+
+template <typename T, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() != std::declval<U>()), bool>)>
+[[nodiscard]] bool operator!=(
+    const recycling_optional<T>& lhs, const recycling_optional<U>& rhs)
+{
+    return static_cast<bool>(lhs) != static_cast<bool>(rhs) ||
+        (static_cast<bool>(lhs) && *lhs != *rhs);
+}
+
+template <typename T>
+[[nodiscard]] bool operator==(const recycling_optional<T>& lhs, nullopt_t) noexcept
+{
+    return !lhs;
+}
+
+template <typename T>
+[[nodiscard]] bool operator!=(const recycling_optional<T>& lhs, nullopt_t) noexcept
+{
+    return static_cast<bool>(lhs);
+}
+
+template <typename T, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() == std::declval<U>()), bool>)>
+[[nodiscard]] bool operator==(const recycling_optional<T>& lhs, const U& rhs)
+{
+    return lhs && *lhs == rhs;
+}
+
+template <typename T, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() != std::declval<U>()), bool>)>
+[[nodiscard]] bool operator!=(const recycling_optional<T>& lhs, const U& rhs)
+{
+    return !lhs || *lhs != rhs;
+}
+
+template <typename T>
+void swap(recycling_optional<T>& lhs, recycling_optional<T>& rhs)
+    noexcept(noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+} // namespace dze
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include <dze/requires.hpp>
+
+namespace dze {
+
+// A type is trivially relocatable when moving an object to a new address and destroying the
+// original is equivalent to copying its bytes and forgetting about the original. Trivially
+// copyable types are trivially relocatable by definition. Other types, e.g. those holding
+// unique ownership of heap memory, may opt in by specializing this trait:
+//
+//   template <>
+//   struct dze::is_trivially_relocatable<my_type> : std::true_type {};
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Move constructs *dest from *source and destroys *source. dest must point to uninitialized
+// storage.
+template <typename T>
+T* relocate_at(T* const source, T* const dest)
+    noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>)
+{
+    if constexpr (is_trivially_relocatable_v<T>)
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(source), sizeof(T));
+    else
+    {
+        ::new (static_cast<void*>(dest)) T(std::move(*source));
+        source->~T();
+    }
+
+    return dest;
+}
+
+// Relocates [first, last) to the uninitialized storage at dest and returns the end of the
+// relocated range. The ranges may overlap for trivially relocatable types; otherwise they
+// must not. If a move constructor throws, the already relocated objects are destroyed and
+// the remaining source objects are left alive.
+template <typename T>
+T* uninitialized_relocate(T* const first, T* const last, T* const dest)
+    noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>)
+{
+    const auto size = static_cast<size_t>(last - first);
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        if (size != 0)
+        {
+            std::memmove(
+                static_cast<void*>(dest), static_cast<const void*>(first), size * sizeof(T));
+        }
+    }
+    else
+    {
+        std::uninitialized_move(first, last, dest);
+        std::destroy(first, last);
+    }
+
+    return dest + size;
+}
+
+// Swaps two objects by relocating them through a buffer.
+template <typename T,
+    DZE_REQUIRES(is_trivially_relocatable_v<T>)>
+void relocate_swap(T& lhs, T& rhs) noexcept
+{
+    alignas(T) std::byte buffer[sizeof(T)];
+    std::memcpy(buffer, static_cast<const void*>(std::addressof(lhs)), sizeof(T));
+    // Self-swaps are allowed, hence memmove.
+    std::memmove(
+        static_cast<void*>(std::addressof(lhs)),
+        static_cast<const void*>(std::addressof(rhs)),
+        sizeof(T));
+    std::memcpy(static_cast<void*>(std::addressof(rhs)), buffer, sizeof(T));
+}
+
+} // namespace dze
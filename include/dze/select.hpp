@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "details/bit.hpp"
+#include "details/bulk.hpp"
+#include "optional.hpp"
+
+namespace dze {
+
+enum class compare_op
+{
+    equal_to,
+    not_equal_to,
+    less,
+    less_equal,
+    greater,
+    greater_equal
+};
+
+namespace details::select_ns {
+
+// Calls f with the function object that implements op.
+template <typename F>
+decltype(auto) visit(const compare_op op, F&& f)
+{
+    switch (op)
+    {
+        case compare_op::equal_to:
+            return f(std::equal_to<>{});
+        case compare_op::not_equal_to:
+            return f(std::not_equal_to<>{});
+        case compare_op::less:
+            return f(std::less<>{});
+        case compare_op::less_equal:
+            return f(std::less_equal<>{});
+        case compare_op::greater:
+            return f(std::greater<>{});
+        case compare_op::greater_equal:
+            return f(std::greater_equal<>{});
+    }
+
+    return f(std::equal_to<>{});
+}
+
+// Calls f(block_index, mask) for each block of optional_ns::block_size elements of
+// [first, last), where the mask has a bit set for every element that satisfies op.
+template <typename T, typename Policy, typename U, typename F>
+void for_each_block(
+    const optional<T, Policy>* const first,
+    const optional<T, Policy>* const last,
+    const compare_op op,
+    const U& value,
+    F&& f)
+{
+    using optional_ns::block_size;
+
+    visit(op, [&](const auto compare) {
+        const auto pred = [&](const auto& elem) { return compare(elem, value); };
+        const auto size = static_cast<size_t>(last - first);
+        for (size_t block = 0; block * block_size < size; ++block)
+        {
+            const auto offset = block * block_size;
+            const auto count = size - offset < block_size ? size - offset : block_size;
+            f(block, optional_ns::match_mask(first + offset, count, pred));
+        }
+    });
+}
+
+} // namespace details::select_ns
+
+// Evaluates `*opt op value` for each optional in [first, last) with SQL semantics, i.e. nulls
+// never match. Bit i % 64 of mask[i / 64] is set for each matching element. mask must have
+// room for (last - first + 63) / 64 words.
+template <typename T, typename Policy, typename U>
+void select_mask(
+    const optional<T, Policy>* const first,
+    const optional<T, Policy>* const last,
+    const compare_op op,
+    const U& value,
+    uint64_t* const mask)
+{
+    details::select_ns::for_each_block(
+        first, last, op, value, [=](const size_t block, const uint64_t bits) {
+            mask[block] = bits;
+        });
+}
+
+// Same as select_mask but writes the indices of the matching elements in ascending order to
+// selection instead and returns their number. selection must have room for last - first
+// indices.
+template <typename T, typename Policy, typename U>
+size_t select(
+    const optional<T, Policy>* const first,
+    const optional<T, Policy>* const last,
+    const compare_op op,
+    const U& value,
+    uint32_t* const selection)
+{
+    using details::optional_ns::block_size;
+
+    size_t count = 0;
+    details::select_ns::for_each_block(
+        first, last, op, value, [&](const size_t block, const uint64_t bits) {
+            const auto offset = static_cast<uint32_t>(block * block_size);
+            details::for_each_set_bit(bits, [&](const unsigned i) {
+                selection[count++] = offset + i;
+            });
+        });
+
+    return count;
+}
+
+} // namespace dze
@@ -2,6 +2,8 @@
 
 #include <cstddef>
 #include <cstring>
+#include <limits>
+#include <type_traits>
 
 #include "optional.hpp"
 
@@ -9,10 +11,22 @@ namespace dze {
 
 namespace details::optional_ns {
 
+// The minimum value of an integral type sorts below all the others.
+template <typename T, auto value>
+[[nodiscard]] constexpr bool is_integral_minimum() noexcept
+{
+    if constexpr (std::is_integral_v<T>)
+        return static_cast<T>(value) == std::numeric_limits<T>::min();
+    else
+        return false;
+}
+
 template <typename T, auto sentinel_value>
 class sentinel_value_policy
 {
 public:
+    static constexpr bool null_sorts_first = is_integral_minimum<T, sentinel_value>();
+
     [[nodiscard]] static bool is_engaged(const std::byte* const storage) noexcept
     {
         return std::memcmp(storage, &sentinel, sizeof(T)) != 0;
@@ -27,6 +41,12 @@ private:
     inline static const T sentinel{sentinel_value};
 };
 
+template <typename Policy>
+constexpr bool is_sentinel_value_policy_v = false;
+
+template <typename T, auto sentinel_value>
+constexpr bool is_sentinel_value_policy_v<sentinel_value_policy<T, sentinel_value>> = true;
+
 } // details::optional_ns
 
 template <typename T, auto sentinel_value>
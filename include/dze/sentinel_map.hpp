@@ -0,0 +1,545 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#include <emmintrin.h>
+#endif
+
+#include <dze/requires.hpp>
+
+#include "details/bit.hpp"
+#include "details/bulk.hpp"
+#include "details/check.hpp"
+#include "optional.hpp"
+#include "sentinel.hpp"
+
+namespace dze {
+
+namespace details::sentinel_map_ns {
+
+// Bytes of keys compared at once, which is a cache line.
+constexpr size_t group_bytes = 64;
+
+// The storage of a value, which is constructed when its key is engaged.
+template <typename V>
+struct value_slot
+{
+    alignas(V) std::byte bytes[sizeof(V)];
+
+    [[nodiscard]] V& get() noexcept { return *std::launder(reinterpret_cast<V*>(bytes)); }
+
+    [[nodiscard]] const V& get() const noexcept
+    {
+        return *std::launder(reinterpret_cast<const V*>(bytes));
+    }
+};
+
+// Sets have no values.
+template <>
+struct value_slot<void> {};
+
+struct aligned_delete
+{
+    template <typename T>
+    void operator()(T* const p) const noexcept
+    {
+        ::operator delete[](p, std::align_val_t{group_bytes});
+    }
+};
+
+struct group_masks
+{
+    uint64_t match;
+    uint64_t free;
+};
+
+#if defined(__SSE2__) || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+
+// The masks have a bit per byte of the group, all of which are set for a matching key.
+template <typename K>
+constexpr size_t mask_stride = sizeof(K);
+
+template <typename K>
+[[nodiscard]] __m128i broadcast(const K key) noexcept
+{
+    if constexpr (sizeof(K) == 1)
+        return _mm_set1_epi8(static_cast<char>(key));
+    else if constexpr (sizeof(K) == 2)
+        return _mm_set1_epi16(static_cast<short>(key));
+    else if constexpr (sizeof(K) == 4)
+        return _mm_set1_epi32(static_cast<int>(key));
+    else
+        return _mm_set1_epi64x(static_cast<long long>(key));
+}
+
+template <typename K>
+[[nodiscard]] __m128i equal(const __m128i lhs, const __m128i rhs) noexcept
+{
+    if constexpr (sizeof(K) == 1)
+        return _mm_cmpeq_epi8(lhs, rhs);
+    else if constexpr (sizeof(K) == 2)
+        return _mm_cmpeq_epi16(lhs, rhs);
+    else if constexpr (sizeof(K) == 4)
+        return _mm_cmpeq_epi32(lhs, rhs);
+    else
+    {
+        // SSE2 has no 64-bit comparison, so both halves of a key must compare equal.
+        const __m128i halves = _mm_cmpeq_epi32(lhs, rhs);
+        return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+}
+
+// group must be aligned to group_bytes.
+template <typename K>
+[[nodiscard]] group_masks match_group(
+    const void* const group, const K key, const K empty_key) noexcept
+{
+    const __m128i target = broadcast(key);
+    const __m128i empty = broadcast(empty_key);
+    group_masks result{0, 0};
+    for (size_t i = 0; i != group_bytes / 16; ++i)
+    {
+        const __m128i keys = _mm_load_si128(static_cast<const __m128i*>(group) + i);
+        result.match |= static_cast<uint64_t>(static_cast<uint16_t>(
+            _mm_movemask_epi8(equal<K>(keys, target)))) << (16 * i);
+        result.free |= static_cast<uint64_t>(static_cast<uint16_t>(
+            _mm_movemask_epi8(equal<K>(keys, empty)))) << (16 * i);
+    }
+
+    return result;
+}
+
+#else
+
+// The masks have a bit per key of the group.
+template <typename K>
+constexpr size_t mask_stride = 1;
+
+template <typename K>
+[[nodiscard]] group_masks match_group(
+    const void* const group, const K key, const K empty_key) noexcept
+{
+    constexpr size_t size = group_bytes / sizeof(K);
+
+    // Like make_mask, the results are collected into bytes first so that compilers vectorize
+    // the comparisons and the packing.
+    uint8_t match[size];
+    uint8_t free[size];
+    for (size_t i = 0; i != size; ++i)
+    {
+        K k;
+        std::memcpy(&k, static_cast<const std::byte*>(group) + i * sizeof(K), sizeof(K));
+        match[i] = static_cast<uint8_t>(k == key);
+        free[i] = static_cast<uint8_t>(k == empty_key);
+    }
+
+    group_masks result{0, 0};
+    for (size_t i = 0; i != size; ++i)
+    {
+        result.match |= static_cast<uint64_t>(match[i]) << i;
+        result.free |= static_cast<uint64_t>(free[i]) << i;
+    }
+
+    return result;
+}
+
+#endif
+
+} // namespace details::sentinel_map_ns
+
+// An open addressing hash map whose keys are sentinel optionals, so that a slot holding the
+// empty key is free and no metadata is kept next to the keys. The keys are stored apart from
+// the values and are probed linearly in groups of a cache line of keys: a lookup compares the
+// whole group against both the key and the empty key with SSE2 where it is available, and
+// stops at the first free slot. Erasing shifts the following keys of
+// the cluster back, so there are no tombstones and lookups never slow down with churn.
+//
+// The keys are hashed with Hash, which defaults to dze::hash of the sentinel optional, and
+// the hashes are spread with a multiplicative mix because std::hash of an integer is often
+// the identity. The empty key itself cannot be inserted. With V void, this is a set.
+template <
+    typename K,
+    typename V,
+    auto EmptyKey,
+    typename Hash = hash<sentinel<K, EmptyKey>>>
+class sentinel_map
+{
+    static_assert(std::is_integral_v<K> || std::is_enum_v<K>);
+    static_assert(sizeof(K) <= 8);
+    static_assert(std::is_void_v<V> || std::is_nothrow_move_constructible_v<V>);
+
+    using key_type = sentinel<K, EmptyKey>;
+
+    static_assert(sizeof(key_type) == sizeof(K));
+
+    static constexpr size_t stride = details::sentinel_map_ns::mask_stride<K>;
+    using value_slot = details::sentinel_map_ns::value_slot<V>;
+
+    static constexpr bool is_set = std::is_void_v<V>;
+    static constexpr K empty_key{EmptyKey};
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+public:
+    using value_type = V;
+
+    // Number of keys compared at once when probing.
+    static constexpr size_t group_size = details::sentinel_map_ns::group_bytes / sizeof(K);
+
+private:
+    static constexpr size_t min_capacity = std::max<size_t>(16, group_size);
+
+public:
+    sentinel_map() = default;
+
+    explicit sentinel_map(const size_t count) { reserve(count); }
+
+    sentinel_map(const sentinel_map& other)
+        : sentinel_map{}
+    {
+        reserve(other.size());
+        if constexpr (is_set)
+            other.for_each([&](const K key) { insert(key); });
+        else
+            other.for_each([&](const K key, const V& value) { try_emplace(key, value); });
+    }
+
+    sentinel_map(sentinel_map&& other) noexcept
+        : m_keys{std::move(other.m_keys)}
+        , m_values{std::move(other.m_values)}
+        , m_mask{std::exchange(other.m_mask, 0)}
+        , m_shift{other.m_shift}
+        , m_size{std::exchange(other.m_size, 0)} {}
+
+    sentinel_map& operator=(const sentinel_map& other)
+    {
+        if (this != &other)
+            sentinel_map{other}.swap(*this);
+
+        return *this;
+    }
+
+    sentinel_map& operator=(sentinel_map&& other) noexcept
+    {
+        if (this != &other)
+            sentinel_map{std::move(other)}.swap(*this);
+
+        return *this;
+    }
+
+    ~sentinel_map() { destroy_values(); }
+
+    void swap(sentinel_map& other) noexcept
+    {
+        using std::swap;
+
+        swap(m_keys, other.m_keys);
+        swap(m_values, other.m_values);
+        swap(m_mask, other.m_mask);
+        swap(m_shift, other.m_shift);
+        swap(m_size, other.m_size);
+    }
+
+    // Makes room for count keys without rehashing.
+    void reserve(const size_t count)
+    {
+        size_t new_capacity = min_capacity;
+        while (max_size_for(new_capacity) < count)
+            new_capacity *= 2;
+
+        if (new_capacity > capacity())
+            rehash(new_capacity);
+    }
+
+    // Returns the value of key and whether it was inserted. Does not construct a value if key
+    // is already present. key must not be the empty key.
+    template <typename... Args,
+        typename U = V,
+        DZE_REQUIRES(!std::is_void_v<U> && std::is_constructible_v<U, Args&&...>)>
+    std::pair<U&, bool> try_emplace(const K key, Args&&... args)
+    {
+        const auto [slot, inserted] = insert_key(key);
+        if (inserted)
+        {
+            // The key is only published once its value is constructed.
+            ::new (static_cast<void*>(m_values[slot].bytes)) V(std::forward<Args>(args)...);
+            m_keys[slot] = key;
+            ++m_size;
+        }
+
+        return {m_values[slot].get(), inserted};
+    }
+
+    template <typename U = V, DZE_REQUIRES(!std::is_void_v<U>)>
+    U& operator[](const K key) { return try_emplace(key).first; }
+
+    // Returns whether key was inserted. key must not be the empty key.
+    template <typename U = V, DZE_REQUIRES(std::is_void_v<U>)>
+    bool insert(const K key)
+    {
+        const auto [slot, inserted] = insert_key(key);
+        if (inserted)
+        {
+            m_keys[slot] = key;
+            ++m_size;
+        }
+
+        return inserted;
+    }
+
+    // The value of key, or nullptr if key is not present.
+    template <typename U = V, DZE_REQUIRES(!std::is_void_v<U>)>
+    [[nodiscard]] U* find(const K key) noexcept
+    {
+        const size_t slot = find_slot(key).first;
+        return slot == npos ? nullptr : std::addressof(m_values[slot].get());
+    }
+
+    template <typename U = V, DZE_REQUIRES(!std::is_void_v<U>)>
+    [[nodiscard]] const U* find(const K key) const noexcept
+    {
+        const size_t slot = find_slot(key).first;
+        return slot == npos ? nullptr : std::addressof(m_values[slot].get());
+    }
+
+    [[nodiscard]] bool contains(const K key) const noexcept
+    {
+        return find_slot(key).first != npos;
+    }
+
+    // Returns whether key was present.
+    bool erase(const K key) noexcept
+    {
+        size_t hole = find_slot(key).first;
+        if (hole == npos)
+            return false;
+
+        destroy_value(hole);
+
+        // Moves back each key of the rest of the cluster whose home is not between the hole
+        // and the key, so that it stays reachable from its home.
+        for (size_t i = next(hole); m_keys[i]; i = next(i))
+        {
+            const K moved = *m_keys[i];
+            if (((i - home(moved)) & m_mask) < ((i - hole) & m_mask))
+                continue;
+
+            m_keys[hole] = moved;
+            if constexpr (!is_set)
+            {
+                ::new (static_cast<void*>(m_values[hole].bytes)) V(
+                    std::move(m_values[i].get()));
+                destroy_value(i);
+            }
+            hole = i;
+        }
+
+        m_keys[hole].reset();
+        --m_size;
+        return true;
+    }
+
+    // Keeps the capacity.
+    void clear() noexcept
+    {
+        destroy_values();
+        std::fill_n(m_keys.get(), capacity(), key_type{});
+        m_size = 0;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    // Number of slots, which is a power of two.
+    [[nodiscard]] size_t capacity() const noexcept { return m_keys ? m_mask + 1 : 0; }
+
+    // Calls f(key, value), or f(key) for a set, for each entry in slot order.
+    template <typename F>
+    void for_each(F f)
+    {
+        for_each_slot([&](const size_t slot) { visit(f, slot); });
+    }
+
+    template <typename F>
+    void for_each(F f) const
+    {
+        for_each_slot([&](const size_t slot) { visit(f, slot); });
+    }
+
+private:
+    [[nodiscard]] static size_t max_size_for(const size_t capacity) noexcept
+    {
+        return capacity / 4 * 3;
+    }
+
+    [[nodiscard]] size_t next(const size_t slot) const noexcept { return (slot + 1) & m_mask; }
+
+    [[nodiscard]] size_t home(const K key) const noexcept
+    {
+        return details::fibonacci_hash(Hash{}(key_type{key}), m_shift);
+    }
+
+    // Returns the slot of key, or npos and the first free slot of its probe sequence.
+    [[nodiscard]] std::pair<size_t, size_t> find_slot(const K key) const noexcept
+    {
+        DZE_OPTIONAL_CHECK(key != empty_key);
+
+        if (!m_keys)
+            return {npos, npos};
+
+        const size_t start = home(key);
+
+        // Most keys are in their home slot, which is cheaper to check alone than the group.
+        const K first = details::optional_ns::access::representation(m_keys[start]);
+        if (first == key)
+            return {start, npos};
+
+        if (first == empty_key)
+            return {npos, start};
+
+        size_t group = start & ~(group_size - 1);
+        uint64_t window = ~uint64_t{0} << (start - group) * stride;
+        for (;;)
+        {
+            auto [match, free] =
+                details::sentinel_map_ns::match_group(m_keys.get() + group, key, empty_key);
+            match &= window;
+            free &= window;
+
+            // The slots past the first free one belong to other clusters.
+            if (free != 0)
+                match &= (free & (~free + 1)) - 1;
+
+            if (match != 0)
+                return {group + details::countr_zero(match) / stride, npos};
+
+            if (free != 0)
+                return {npos, group + details::countr_zero(free) / stride};
+
+            group = (group + group_size) & m_mask;
+            window = ~uint64_t{0};
+        }
+    }
+
+    // Returns the slot of key and whether it is a free slot for key.
+    std::pair<size_t, bool> insert_key(const K key)
+    {
+        auto [slot, free] = find_slot(key);
+        if (slot != npos)
+            return {slot, false};
+
+        if (m_size + 1 > max_size_for(capacity()))
+        {
+            rehash(capacity() == 0 ? min_capacity : capacity() * 2);
+            free = find_slot(key).second;
+        }
+
+        return {free, true};
+    }
+
+    void rehash(const size_t new_capacity)
+    {
+        auto keys = allocate_keys(new_capacity);
+        std::unique_ptr<value_slot[]> values;
+        if constexpr (!is_set)
+            values.reset(new value_slot[new_capacity]);
+
+        auto old_keys = std::exchange(m_keys, std::move(keys));
+        auto old_values = std::exchange(m_values, std::move(values));
+        const size_t old_capacity = old_keys ? m_mask + 1 : 0;
+        m_mask = new_capacity - 1;
+        m_shift = 64 - details::popcount(m_mask);
+
+        for (size_t i = 0; i != old_capacity; ++i)
+        {
+            if (!old_keys[i])
+                continue;
+
+            const K key = *old_keys[i];
+            const size_t slot = find_slot(key).second;
+            m_keys[slot] = key;
+            if constexpr (!is_set)
+            {
+                V& value = old_values[i].get();
+                ::new (static_cast<void*>(m_values[slot].bytes)) V(std::move(value));
+                value.~V();
+            }
+        }
+    }
+
+    [[nodiscard]] static auto allocate_keys(const size_t count)
+    {
+        using details::sentinel_map_ns::group_bytes;
+
+        std::unique_ptr<key_type[], details::sentinel_map_ns::aligned_delete> result{
+            static_cast<key_type*>(
+                ::operator new[](count * sizeof(key_type), std::align_val_t{group_bytes}))};
+        std::uninitialized_default_construct_n(result.get(), count);
+        return result;
+    }
+
+    template <typename F>
+    void for_each_slot(F f) const
+    {
+        using details::optional_ns::block_size;
+
+        for (size_t first = 0; first < capacity(); first += block_size)
+        {
+            const size_t count = std::min(block_size, capacity() - first);
+            details::for_each_set_bit(
+                details::optional_ns::engagement_mask(m_keys.get() + first, count),
+                [&](const unsigned i) { f(first + i); });
+        }
+    }
+
+    template <typename F>
+    void visit(F& f, const size_t slot)
+    {
+        if constexpr (is_set)
+            f(*m_keys[slot]);
+        else
+            f(*m_keys[slot], m_values[slot].get());
+    }
+
+    template <typename F>
+    void visit(F& f, const size_t slot) const
+    {
+        if constexpr (is_set)
+            f(*m_keys[slot]);
+        else
+            f(*m_keys[slot], m_values[slot].get());
+    }
+
+    void destroy_value([[maybe_unused]] const size_t slot) noexcept
+    {
+        if constexpr (!is_set)
+            m_values[slot].get().~V();
+    }
+
+    void destroy_values() noexcept
+    {
+        if constexpr (!is_set && !std::is_trivially_destructible_v<V>)
+            for_each_slot([&](const size_t slot) { destroy_value(slot); });
+    }
+
+    std::unique_ptr<key_type[], details::sentinel_map_ns::aligned_delete> m_keys;
+    // Unused for sets.
+    std::unique_ptr<value_slot[]> m_values;
+    size_t m_mask = 0;
+    // Turns a 64-bit hash into a slot.
+    unsigned m_shift = 64;
+    size_t m_size = 0;
+};
+
+template <typename K, auto EmptyKey, typename Hash = hash<sentinel<K, EmptyKey>>>
+using sentinel_set = sentinel_map<K, void, EmptyKey, Hash>;
+
+} // namespace dze
@@ -0,0 +1,370 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include <dze/requires.hpp>
+
+#include "bad_optional_access.hpp"
+#include "details/check.hpp"
+#include "nullopt.hpp"
+#include "optional.hpp"
+#include "relocate.hpp"
+
+namespace dze {
+
+namespace details::shared_ns {
+
+template <bool ThreadSafe>
+class refcount
+{
+public:
+    void increment() noexcept { m_count.fetch_add(1, std::memory_order_relaxed); }
+
+    // Returns true when the last reference was dropped.
+    [[nodiscard]] bool decrement() noexcept
+    {
+        return m_count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    [[nodiscard]] size_t get() const noexcept
+    {
+        return m_count.load(std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<size_t> m_count{1};
+};
+
+template <>
+class refcount<false>
+{
+public:
+    void increment() noexcept { ++m_count; }
+
+    [[nodiscard]] bool decrement() noexcept { return --m_count == 0; }
+
+    [[nodiscard]] size_t get() const noexcept { return m_count; }
+
+private:
+    size_t m_count = 1;
+};
+
+template <typename T, bool ThreadSafe>
+struct node
+{
+    refcount<ThreadSafe> count;
+    // Cleared once a non-const observer has handed out a reference to the value, after which
+    // copies get their own value. Only written by the sole owner of the node.
+    bool shareable = true;
+    T value;
+
+    template <typename... Args>
+    explicit node(std::in_place_t, Args&&... args)
+        : value(std::forward<Args>(args)...) {}
+};
+
+} // namespace details::shared_ns
+
+// An optional whose value lives on the heap and is shared between copies through an
+// intrusive reference count, so that copying is O(1) regardless of the size of the value.
+// A null pointer is the disengaged state.
+//
+// Copies share the value until one of them is accessed through a non-const observer, which
+// first copies the value if it is shared. Use std::as_const to read a non-const object
+// without unsharing it. The reference count is atomic unless ThreadSafe is false, which
+// suits objects that are confined to a single thread.
+//
+// A reference from a non-const observer may be written through after the call, so the value
+// it refers to is never shared again, like a leaked copy-on-write string: later copies copy
+// the value, until the value is replaced by emplace, reset or assigning a shared_optional.
+//
+//   T& r = *a;  // a owns its value, which is no longer shareable.
+//   auto b = a; // b gets its own copy.
+//   r = x;      // Leaves *b unchanged.
+template <typename T, bool ThreadSafe = true>
+class shared_optional
+{
+    static_assert(!std::is_same_v<std::remove_cv_t<T>, nullopt_t>);
+    static_assert(!std::is_same_v<std::remove_cv_t<T>, std::in_place_t>);
+    static_assert(!std::is_reference_v<T>);
+    static_assert(!std::is_const_v<T>);
+
+    using node = details::shared_ns::node<T, ThreadSafe>;
+
+public:
+    using value_type = T;
+
+    constexpr shared_optional() noexcept = default;
+
+    constexpr shared_optional(nullopt_t) noexcept {}
+
+    template <typename U = T,
+        DZE_REQUIRES(
+            !std::is_same_v<shared_optional, std::decay_t<U>> &&
+            !std::is_same_v<std::in_place_t, std::decay_t<U>> &&
+            std::is_constructible_v<T, U&&> &&
+            std::is_convertible_v<U&&, T>)>
+    shared_optional(U&& value)
+        : m_node{new node{std::in_place, std::forward<U>(value)}} {}
+
+    template <typename U = T,
+        DZE_REQUIRES(
+            !std::is_same_v<shared_optional, std::decay_t<U>> &&
+            !std::is_same_v<std::in_place_t, std::decay_t<U>> &&
+            std::is_constructible_v<T, U&&> &&
+            !std::is_convertible_v<U&&, T>)>
+    explicit shared_optional(U&& value)
+        : m_node{new node{std::in_place, std::forward<U>(value)}} {}
+
+    template <typename... Args,
+        DZE_REQUIRES(std::is_constructible_v<T, Args&&...>)>
+    explicit shared_optional(std::in_place_t, Args&&... args)
+        : m_node{new node{std::in_place, std::forward<Args>(args)...}} {}
+
+    // Copies the value if other handed out a reference to it.
+    shared_optional(const shared_optional& other)
+        : m_node{other.share()} {}
+
+    shared_optional(shared_optional&& other) noexcept
+        : m_node{std::exchange(other.m_node, nullptr)} {}
+
+    ~shared_optional() { reset(); }
+
+    shared_optional& operator=(const shared_optional& other)
+    {
+        // Also makes self-assignment a no-op.
+        if (m_node == other.m_node)
+            return *this;
+
+        node* const n = other.share();
+        reset();
+        m_node = n;
+        return *this;
+    }
+
+    shared_optional& operator=(shared_optional&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            m_node = std::exchange(other.m_node, nullptr);
+        }
+
+        return *this;
+    }
+
+    shared_optional& operator=(nullopt_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    // Assigns in place when this is the only owner of its value.
+    template <typename U = T,
+        DZE_REQUIRES(
+            !std::is_same_v<shared_optional, std::decay_t<U>> &&
+            std::is_constructible_v<T, U&&> &&
+            std::is_assignable_v<T&, U&&>)>
+    shared_optional& operator=(U&& value)
+    {
+        if (unique())
+            m_node->value = std::forward<U>(value);
+        else
+            emplace(std::forward<U>(value));
+
+        return *this;
+    }
+
+    template <typename... Args,
+        DZE_REQUIRES(std::is_constructible_v<T, Args&&...>)>
+    T& emplace(Args&&... args)
+    {
+        node* const n = new node{std::in_place, std::forward<Args>(args)...};
+        reset();
+        m_node = n;
+        return n->value;
+    }
+
+    void reset() noexcept
+    {
+        if (m_node)
+        {
+            if (m_node->count.decrement())
+                delete m_node;
+            m_node = nullptr;
+        }
+    }
+
+    void swap(shared_optional& other) noexcept { std::swap(m_node, other.m_node); }
+
+    // Number of shared_optionals sharing the value, or 0 if disengaged.
+    [[nodiscard]] size_t use_count() const noexcept
+    {
+        return m_node ? m_node->count.get() : 0;
+    }
+
+    [[nodiscard]] bool unique() const noexcept { return use_count() == 1; }
+
+    // True when both share the same value or are both disengaged.
+    [[nodiscard]] bool shares_with(const shared_optional& other) const noexcept
+    {
+        return m_node == other.m_node;
+    }
+
+    const T* operator->() const noexcept
+    {
+        DZE_OPTIONAL_CHECK(m_node);
+
+        return std::addressof(m_node->value);
+    }
+
+    T* operator->()
+    {
+        DZE_OPTIONAL_CHECK(m_node);
+
+        unshare();
+        m_node->shareable = false;
+        return std::addressof(m_node->value);
+    }
+
+    const T& operator*() const& noexcept { return *operator->(); }
+
+    T& operator*() & { return *operator->(); }
+
+    T&& operator*() && { return std::move(*operator->()); }
+
+    explicit operator bool() const noexcept { return m_node != nullptr; }
+
+    [[nodiscard]] bool has_value() const noexcept { return m_node != nullptr; }
+
+    [[nodiscard]] const T& value() const&
+    {
+        if (!m_node)
+            details::bad_optional_access_failure();
+
+        return m_node->value;
+    }
+
+    [[nodiscard]] T& value() &
+    {
+        if (!m_node)
+            details::bad_optional_access_failure();
+
+        return **this;
+    }
+
+    [[nodiscard]] T&& value() &&
+    {
+        if (!m_node)
+            details::bad_optional_access_failure();
+
+        return std::move(**this);
+    }
+
+    template <typename U>
+    [[nodiscard]] T value_or(U&& default_value) const&
+    {
+        static_assert(std::is_copy_constructible_v<T>);
+        static_assert(std::is_convertible_v<U&&, T>);
+
+        return m_node ? m_node->value : static_cast<T>(std::forward<U>(default_value));
+    }
+
+private:
+    // The node for a copy of this: the same one, or a copy if it is not shareable.
+    [[nodiscard]] node* share() const
+    {
+        if (!m_node)
+            return nullptr;
+
+        if (!m_node->shareable)
+            return new node{std::in_place, std::as_const(m_node->value)};
+
+        m_node->count.increment();
+        return m_node;
+    }
+
+    // Gives this its own copy of the value if it is shared.
+    void unshare()
+    {
+        if (m_node->count.get() != 1)
+        {
+            node* const n = new node{std::in_place, std::as_const(m_node->value)};
+            reset();
+            m_node = n;
+        }
+    }
+
+    node* m_node = nullptr;
+};
+
+template <typename T>
+using local_shared_optional = shared_optional<T, false>;
+
+template <typename T, bool ThreadSafe>
+struct is_trivially_relocatable<shared_optional<T, ThreadSafe>> : std::true_type {};
+
+template <typename T, bool ThreadSafe>
+[[nodiscard]] bool operator==(
+    const shared_optional<T, ThreadSafe>& lhs, const shared_optional<T, ThreadSafe>& rhs)
+{
+    return static_cast<bool>(lhs) == static_cast<bool>(rhs) && (!lhs || *lhs == *rhs);
+}
+
+template <typename T, bool ThreadSafe>
+[[nodiscard]] bool operator!=(
+    const shared_optional<T, ThreadSafe>& lhs, const shared_optional<T, ThreadSafe>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <typename T, bool ThreadSafe>
+[[nodiscard]] bool operator==(const shared_optional<T, ThreadSafe>& lhs, nullopt_t) noexcept
+{
+    return !lhs;
+}
+
+template <typename T, bool ThreadSafe>
+[[nodiscard]] bool operator!=(const shared_optional<T, ThreadSafe>& lhs, nullopt_t) noexcept
+{
+    return static_cast<bool>(lhs);
+}
+
+template <typename T, bool ThreadSafe, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() == std::declval<U>()), bool>)>
+[[nodiscard]] bool operator==(const shared_optional<T, ThreadSafe>& lhs, const U& rhs)
+{
+    return lhs && *lhs == rhs;
+}
+
+template <typename T, bool ThreadSafe, typename U,
+    DZE_REQUIRES(std::is_convertible_v<decltype(std::declval<T>() != std::declval<U>()), bool>)>
+[[nodiscard]] bool operator!=(const shared_optional<T, ThreadSafe>& lhs, const U& rhs)
+{
+    return !lhs || *lhs != rhs;
+}
+
+template <typename T, bool ThreadSafe>
+void swap(shared_optional<T, ThreadSafe>& lhs, shared_optional<T, ThreadSafe>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+// Hashes like dze::optional so that both can be used interchangeably as keys.
+template <typename T, bool ThreadSafe>
+struct hash<shared_optional<T, ThreadSafe>>
+{
+    size_t operator()(const shared_optional<T, ThreadSafe>& opt) const
+    {
+        using std::hash;
+
+        constexpr auto magic_disengaged_hash = static_cast<size_t>(-3333);
+        return opt ? hash<T>{}(*opt) : magic_disengaged_hash;
+    }
+};
+
+} // namespace dze
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace dze {
+
+// Fixed-size allocator for objects of type T. Memory is carved out of slabs of SlabSize
+// objects and recycled through free lists, so allocation and deallocation are a few loads and
+// stores in the common case and objects allocated together are adjacent in memory.
+//
+// Each thread allocates from its own free list. Memory may be deallocated on any thread and
+// joins the free list of that thread. A thread keeps at most 2 * SlabSize free objects and
+// hands the rest over to a shared list, so memory freed by one thread and allocated by
+// another is reused instead of piling up. Other threads refill from the shared list one slab's
+// worth at a time, and the free list of an exiting thread is handed over to it. Slabs are
+// never returned to the system.
+//
+// Once the free list of a thread is gone, e.g. when objects with static storage duration are
+// destroyed on the main thread after its thread locals, the thread allocates from and
+// deallocates to the shared list under its lock.
+template <typename T, size_t SlabSize = 64>
+class slab_pool
+{
+    static_assert(SlabSize != 0);
+
+public:
+    [[nodiscard]] static void* allocate()
+    {
+        cache* const c = usable_cache();
+        if (!c)
+        {
+            auto& state = shared();
+            const std::lock_guard lock{state.mutex};
+            if (!state.free)
+                state.free = new_slab(state);
+
+            return pop(state.free);
+        }
+
+        if (!c->free)
+            refill(*c);
+
+        --c->count;
+        return pop(c->free);
+    }
+
+    static void deallocate(void* const ptr) noexcept
+    {
+        node* const n = static_cast<node*>(ptr);
+        cache* const c = usable_cache();
+        if (!c)
+        {
+            auto& state = shared();
+            const std::lock_guard lock{state.mutex};
+            n->next = state.free;
+            state.free = n;
+            return;
+        }
+
+        n->next = c->free;
+        c->free = n;
+        if (++c->count == 2 * SlabSize)
+        {
+            // Keeps the most recently freed half, which is the most likely to be cached.
+            node* last = c->free;
+            for (size_t i = 1; i != SlabSize; ++i)
+                last = last->next;
+
+            give_back(last->next);
+            last->next = nullptr;
+            c->count = SlabSize;
+        }
+    }
+
+    // Number of slabs allocated so far.
+    [[nodiscard]] static size_t slab_count()
+    {
+        auto& state = shared();
+        const std::lock_guard lock{state.mutex};
+        return state.slabs.size();
+    }
+
+private:
+    union node
+    {
+        node* next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    struct shared_state
+    {
+        std::mutex mutex;
+        node* free = nullptr;
+        std::vector<node*> slabs;
+    };
+
+    // Trivially destructible, so that it stays usable until the thread ends.
+    struct cache
+    {
+        node* free = nullptr;
+        size_t count = 0;
+        bool registered = false;
+        bool destroyed = false;
+    };
+
+    // Hands the free list of an exiting thread over to the shared list.
+    struct cache_guard
+    {
+        cache_guard() = default;
+
+        cache_guard(const cache_guard&) = delete;
+        cache_guard& operator=(const cache_guard&) = delete;
+
+        ~cache_guard()
+        {
+            cache& c = local_cache();
+            give_back(c.free);
+            c.free = nullptr;
+            c.count = 0;
+            c.destroyed = true;
+        }
+    };
+
+    // Intentionally leaked so that objects with static storage duration can still be
+    // deallocated during program exit.
+    static shared_state& shared()
+    {
+        static auto* const state = new shared_state;
+        return *state;
+    }
+
+    static cache& local_cache() noexcept
+    {
+        thread_local cache c;
+        return c;
+    }
+
+    // The cache of this thread, or nullptr once it has been handed over.
+    static cache* usable_cache() noexcept
+    {
+        cache& c = local_cache();
+        if (c.destroyed)
+            return nullptr;
+
+        if (!c.registered)
+        {
+            thread_local cache_guard guard;
+            static_cast<void>(guard);
+            c.registered = true;
+        }
+
+        return &c;
+    }
+
+    [[nodiscard]] static node* pop(node*& list) noexcept
+    {
+        node* const result = list;
+        list = result->next;
+        return result;
+    }
+
+    // Prepends a null-terminated list to the shared list.
+    static void give_back(node* const first) noexcept
+    {
+        if (!first)
+            return;
+
+        node* last = first;
+        while (last->next)
+            last = last->next;
+
+        auto& state = shared();
+        const std::lock_guard lock{state.mutex};
+        last->next = state.free;
+        state.free = first;
+    }
+
+    // Returns the objects of a new slab as a null-terminated list. Requires the lock.
+    [[nodiscard]] static node* new_slab(shared_state& state)
+    {
+        state.slabs.reserve(state.slabs.size() + 1);
+        node* const slab = new node[SlabSize];
+        state.slabs.push_back(slab);
+        for (size_t i = 0; i + 1 != SlabSize; ++i)
+            slab[i].next = slab + i + 1;
+        slab[SlabSize - 1].next = nullptr;
+        return slab;
+    }
+
+    static void refill(cache& c)
+    {
+        auto& state = shared();
+        const std::lock_guard lock{state.mutex};
+        if (!state.free)
+        {
+            c.free = new_slab(state);
+            c.count = SlabSize;
+            return;
+        }
+
+        // Takes at most a slab's worth, so that threads share the list.
+        node* last = state.free;
+        size_t count = 1;
+        for (; count != SlabSize && last->next; ++count)
+            last = last->next;
+
+        c.free = state.free;
+        c.count = count;
+        state.free = last->next;
+        last->next = nullptr;
+    }
+};
+
+} // namespace dze
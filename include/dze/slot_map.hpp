@@ -0,0 +1,357 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dze/requires.hpp>
+
+#include "details/check.hpp"
+#include "details/relocating_vector.hpp"
+#include "optional.hpp"
+#include "relocate.hpp"
+#include "views.hpp"
+
+namespace dze {
+
+namespace details::slot_map_ns {
+
+[[noreturn]] DZE_OPTIONAL_COLD inline void too_many_slots()
+{
+#if DZE_OPTIONAL_HAS_EXCEPTIONS
+    throw std::length_error{"dze::slot_map: too many slots"};
+#else
+    std::abort();
+#endif
+}
+
+} // namespace details::slot_map_ns
+
+// A handle to an element of a slot_map. It stays valid until the element is erased, after
+// which the map rejects it even if the slot is reused.
+struct slot_map_handle
+{
+    uint32_t index;
+    uint32_t generation;
+};
+
+[[nodiscard]] constexpr bool operator==(
+    const slot_map_handle lhs, const slot_map_handle rhs) noexcept
+{
+    return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+[[nodiscard]] constexpr bool operator!=(
+    const slot_map_handle lhs, const slot_map_handle rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+// A container with O(1) insertion, erasure and lookup through handles that remain stable when
+// other elements are inserted or erased. The elements are kept in a vector of optionals that
+// only grows, so once it has reached its peak size, inserting and erasing do not allocate.
+// Growing relocates the optionals, which copies their bytes for trivially relocatable T.
+//
+// The free slots form a list whose links are kept in the storage of their disengaged
+// optionals when it is large enough, and otherwise in a vector with room for every slot, so
+// that erasing never allocates. Each slot has a generation that is incremented when its
+// element is erased, which invalidates the handles to it. Iteration visits the elements in
+// slot order and scans the slots in blocks of engagement bits, like dze::views::engaged.
+template <typename T>
+class slot_map
+{
+    static_assert(!std::is_reference_v<T>);
+    static_assert(!std::is_const_v<T>);
+
+    using optional_type = optional<T>;
+
+    static constexpr uint32_t npos = static_cast<uint32_t>(-1);
+    static constexpr bool links_in_storage = sizeof(T) >= sizeof(uint32_t);
+
+public:
+    using value_type = T;
+    using handle = slot_map_handle;
+
+    slot_map() = default;
+
+    slot_map(const slot_map& other)
+        : m_values{other.m_values}
+        , m_generations{other.m_generations}
+        , m_size{other.m_size}
+    {
+        if constexpr (!links_in_storage)
+            m_free_slots.reserve(m_values.size());
+        rebuild_free_list();
+    }
+
+    slot_map(slot_map&& other) noexcept
+        : m_values{std::move(other.m_values)}
+        , m_generations{std::move(other.m_generations)}
+        , m_free_slots{std::move(other.m_free_slots)}
+        , m_free_head{std::exchange(other.m_free_head, npos)}
+        , m_size{std::exchange(other.m_size, 0)}
+    {
+        other.m_values.clear();
+        other.m_generations.clear();
+        other.m_free_slots.clear();
+    }
+
+    slot_map& operator=(const slot_map& other)
+    {
+        if (this != &other)
+            slot_map{other}.swap(*this);
+
+        return *this;
+    }
+
+    slot_map& operator=(slot_map&& other) noexcept
+    {
+        if (this != &other)
+            slot_map{std::move(other)}.swap(*this);
+
+        return *this;
+    }
+
+    ~slot_map() = default;
+
+    void swap(slot_map& other) noexcept
+    {
+        using std::swap;
+
+        swap(m_values, other.m_values);
+        swap(m_generations, other.m_generations);
+        swap(m_free_slots, other.m_free_slots);
+        swap(m_free_head, other.m_free_head);
+        swap(m_size, other.m_size);
+    }
+
+    // Reserves slots for count elements.
+    void reserve(const size_t count)
+    {
+        if (count > npos)
+            details::slot_map_ns::too_many_slots();
+
+        const optional_type* const values = m_values.data();
+        m_values.reserve(count);
+        // Moving a disengaged optional leaves its storage behind, and with it the links.
+        // Relocating its bytes keeps them.
+        if constexpr (links_in_storage && !is_trivially_relocatable_v<optional_type>)
+        {
+            if (m_values.data() != values)
+                rebuild_free_list();
+        }
+
+        m_generations.reserve(count);
+        if constexpr (!links_in_storage)
+            m_free_slots.reserve(count);
+    }
+
+    template <typename... Args,
+        DZE_REQUIRES(std::is_constructible_v<T, Args&&...>)>
+    handle emplace(Args&&... args)
+    {
+        uint32_t index;
+        if (has_free_slot())
+        {
+            index = peek_free();
+            if constexpr (links_in_storage)
+            {
+                const uint32_t next = read_link(index);
+
+                // A throwing constructor may have overwritten the link.
+                struct guard
+                {
+                    slot_map* self;
+                    uint32_t index;
+                    uint32_t next;
+
+                    ~guard()
+                    {
+                        if (self)
+                            self->write_link(index, next);
+                    }
+                } g{this, index, next};
+
+                m_values[index].emplace(std::forward<Args>(args)...);
+                g.self = nullptr;
+                m_free_head = next;
+            }
+            else
+            {
+                m_values[index].emplace(std::forward<Args>(args)...);
+                m_free_slots.pop_back();
+            }
+        }
+        else
+        {
+            if (m_values.size() == npos)
+                details::slot_map_ns::too_many_slots();
+
+            index = static_cast<uint32_t>(m_values.size());
+            m_generations.reserve(m_generations.size() + 1);
+            if constexpr (!links_in_storage)
+            {
+                // Grows geometrically like the slots, which stay fewer than its capacity.
+                if (m_free_slots.capacity() == m_values.size())
+                    m_free_slots.reserve(std::max<size_t>(2 * m_values.size(), 1));
+            }
+            m_values.emplace_back(std::in_place, std::forward<Args>(args)...);
+            m_generations.push_back(0);
+        }
+
+        ++m_size;
+        return {index, m_generations[index]};
+    }
+
+    handle insert(const T& value) { return emplace(value); }
+
+    handle insert(T&& value) { return emplace(std::move(value)); }
+
+    // Returns false if h does not refer to an element.
+    bool erase(const handle h) noexcept
+    {
+        if (!contains(h))
+            return false;
+
+        m_values[h.index].reset();
+        ++m_generations[h.index];
+        push_free(h.index);
+        --m_size;
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        for (size_t i = 0; i != m_values.size(); ++i)
+        {
+            if (m_values[i])
+            {
+                m_values[i].reset();
+                ++m_generations[i];
+            }
+        }
+
+        m_size = 0;
+        rebuild_free_list();
+    }
+
+    [[nodiscard]] bool contains(const handle h) const noexcept
+    {
+        return h.index < m_values.size() && m_generations[h.index] == h.generation &&
+            m_values[h.index].has_value();
+    }
+
+    // The element h refers to, or nullptr if there is none.
+    [[nodiscard]] T* get(const handle h) noexcept
+    {
+        return contains(h) ? std::addressof(*m_values[h.index]) : nullptr;
+    }
+
+    [[nodiscard]] const T* get(const handle h) const noexcept
+    {
+        return contains(h) ? std::addressof(*m_values[h.index]) : nullptr;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    // Number of slots, which only grows.
+    [[nodiscard]] size_t slot_count() const noexcept { return m_values.size(); }
+
+    [[nodiscard]] auto begin() { return views::engaged(m_values).begin(); }
+
+    [[nodiscard]] auto begin() const { return views::engaged(m_values).begin(); }
+
+    [[nodiscard]] auto end() const noexcept { return views::engaged(m_values).end(); }
+
+    // Calls f(handle, element) for each element in slot order.
+    template <typename F>
+    void for_each(F f)
+    {
+        for (auto&& [index, value] : views::enumerate_engaged(m_values))
+            f(handle{static_cast<uint32_t>(index), m_generations[index]}, value);
+    }
+
+    template <typename F>
+    void for_each(F f) const
+    {
+        for (auto&& [index, value] : views::enumerate_engaged(m_values))
+            f(handle{static_cast<uint32_t>(index), m_generations[index]}, value);
+    }
+
+private:
+    [[nodiscard]] bool has_free_slot() const noexcept
+    {
+        if constexpr (links_in_storage)
+            return m_free_head != npos;
+        else
+            return !m_free_slots.empty();
+    }
+
+    [[nodiscard]] uint32_t peek_free() const noexcept
+    {
+        if constexpr (links_in_storage)
+            return m_free_head;
+        else
+            return m_free_slots.back();
+    }
+
+    void push_free(const uint32_t index) noexcept
+    {
+        if constexpr (links_in_storage)
+        {
+            write_link(index, m_free_head);
+            m_free_head = index;
+        }
+        else
+            m_free_slots.push_back(index);
+    }
+
+    [[nodiscard]] uint32_t read_link(const uint32_t index) noexcept
+    {
+        uint32_t result;
+        std::memcpy(
+            &result,
+            details::optional_ns::access::idle_storage(m_values[index]),
+            sizeof(uint32_t));
+        return result;
+    }
+
+    void write_link(const uint32_t index, const uint32_t next) noexcept
+    {
+        std::memcpy(
+            details::optional_ns::access::idle_storage(m_values[index]),
+            &next,
+            sizeof(uint32_t));
+    }
+
+    // Links the disengaged slots so that the lowest index is reused first. m_free_slots must
+    // have room for every slot.
+    void rebuild_free_list() noexcept
+    {
+        m_free_head = npos;
+        m_free_slots.clear();
+        for (size_t i = m_values.size(); i-- != 0;)
+        {
+            if (!m_values[i])
+                push_free(static_cast<uint32_t>(i));
+        }
+    }
+
+    details::relocating_vector<optional_type> m_values;
+    std::vector<uint32_t> m_generations;
+    // Only used when the links do not fit in the storage of the elements.
+    std::vector<uint32_t> m_free_slots;
+    uint32_t m_free_head = npos;
+    size_t m_size = 0;
+};
+
+} // namespace dze
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "details/bit.hpp"
+#include "details/bulk.hpp"
+#include "details/check.hpp"
+#include "details/radix_sort.hpp"
+#include "optional.hpp"
+
+namespace dze {
+
+// Placement of the disengaged elements in a sorted range of optionals.
+enum class null_order
+{
+    first,
+    last
+};
+
+namespace details::sort_ns {
+
+template <typename It>
+using optional_type = typename std::iterator_traits<It>::value_type;
+
+template <typename It>
+using optional_value_type = typename optional_type<It>::value_type;
+
+template <typename It>
+constexpr bool use_radix_sort_v =
+    optional_ns::is_optional_v<optional_type<It>> &&
+    is_radix_sortable_v<std::remove_const_t<optional_value_type<It>>>;
+
+// Below this many elements per thread, parallel sorting is not worth spawning threads for.
+constexpr size_t min_parallel_chunk = size_t{1} << 14;
+
+// Copies the engaged values in [first, last) to out and returns how many there are.
+// out must have room for last - first elements.
+template <typename It, typename T>
+size_t copy_engaged(It first, const It last, T* const out)
+{
+    using policy = typename optional_type<It>::policy_type;
+
+    size_t count = 0;
+    for (; first != last; ++first)
+    {
+        const auto& opt = *first;
+        if constexpr (optional_ns::representation_is_value_v<T, policy>)
+        {
+            // The null representation is stored unconditionally and then overwritten.
+            out[count] = optional_ns::access::representation(opt);
+            count += static_cast<size_t>(opt.has_value());
+        }
+        else if (opt)
+            out[count++] = *opt;
+    }
+
+    return count;
+}
+
+// Writes back the sorted engaged values and the nulls to [first, last).
+template <typename It, typename T>
+void assign_sorted(
+    const It first,
+    const It last,
+    const T* const values,
+    const size_t count,
+    const null_order order)
+{
+    const auto nulls = static_cast<size_t>(last - first) - count;
+    const auto null_first = order == null_order::first ? first : first + count;
+    auto value_it = order == null_order::first ? first + nulls : first;
+
+    std::for_each(null_first, null_first + nulls, [](auto& opt) { opt.reset(); });
+    for (auto it = values; it != values + count; ++it, ++value_it)
+        value_it->emplace(*it);
+}
+
+// Moves the disengaged elements to the front or back of the range and returns the subrange of
+// the engaged elements. Engagement is tested a block at a time into a mask without branches,
+// which compilers vectorize for optionals whose engagement is a comparison of the value, and
+// only the elements to move to the front are visited.
+template <typename It>
+std::pair<It, It> partition_nulls(const It first, const It last, const null_order order)
+{
+    const auto size = static_cast<size_t>(last - first);
+    const bool front_engaged = order == null_order::last;
+
+    // Everything between out and the current element belongs at the back.
+    It out = first;
+    for (size_t block = 0; block < size; block += optional_ns::block_size)
+    {
+        const It block_first = first + static_cast<std::ptrdiff_t>(block);
+        const auto count = std::min(optional_ns::block_size, size - block);
+        const uint64_t mask = optional_ns::make_mask(count, [&](const size_t i) {
+            return block_first[static_cast<std::ptrdiff_t>(i)].has_value() == front_engaged;
+        });
+
+        for_each_set_bit(mask, [&](const unsigned i) {
+            const It it = block_first + static_cast<std::ptrdiff_t>(i);
+            if (it != out)
+                std::iter_swap(out, it);
+            ++out;
+        });
+    }
+
+    if (front_engaged)
+        return {first, out};
+    else
+        return {out, last};
+}
+
+inline constexpr auto compare_engaged = [](const auto& lhs, const auto& rhs) {
+    return *lhs < *rhs;
+};
+
+// The order of radix_sort, which unlike operator< is a strict weak ordering with NaNs.
+inline constexpr auto compare_radix_keys = [](const auto lhs, const auto rhs) {
+    return radix_key(lhs) < radix_key(rhs);
+};
+
+// Runs f(0), ..., f(count - 1) on separate threads and rethrows the first exception thrown by
+// any of them.
+template <typename F>
+void run_parallel(const size_t count, F f)
+{
+    std::vector<std::exception_ptr> exceptions(count);
+    const auto run = [&](const size_t i) noexcept {
+#if DZE_OPTIONAL_HAS_EXCEPTIONS
+        try
+        {
+            f(i);
+        }
+        catch (...)
+        {
+            exceptions[i] = std::current_exception();
+        }
+#else
+        f(i);
+#endif
+    };
+
+    {
+        std::vector<std::thread> threads;
+
+        // Joins the started threads, also when starting another one throws.
+        struct guard
+        {
+            std::vector<std::thread>& threads;
+
+            ~guard()
+            {
+                for (auto& thread : threads)
+                {
+                    if (thread.joinable())
+                        thread.join();
+                }
+            }
+        } const join{threads};
+
+        threads.reserve(count - 1);
+        for (size_t i = 1; i < count; ++i)
+            threads.emplace_back(run, i);
+        run(0);
+    }
+
+    for (auto& exception : exceptions)
+    {
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+}
+
+// Sorts equally sized chunks of [first, last) with sort_chunk on separate threads and then
+// merges the sorted chunks pairwise, halving the number of chunks in each parallel round.
+template <typename It, typename Compare, typename SortChunk>
+void parallel_sort(
+    const It first, const It last, Compare compare, SortChunk sort_chunk, size_t concurrency)
+{
+    const auto size = static_cast<size_t>(last - first);
+    concurrency = std::max<size_t>(1, std::min(concurrency, size / min_parallel_chunk));
+    if (concurrency == 1)
+    {
+        sort_chunk(first, last);
+        return;
+    }
+
+    std::vector<It> bounds;
+    bounds.reserve(concurrency + 1);
+    for (size_t i = 0; i != concurrency; ++i)
+        bounds.push_back(first + static_cast<std::ptrdiff_t>(size * i / concurrency));
+    bounds.push_back(last);
+
+    run_parallel(concurrency, [&](const size_t i) { sort_chunk(bounds[i], bounds[i + 1]); });
+
+    while (bounds.size() > 2)
+    {
+        run_parallel((bounds.size() - 1) / 2, [&](const size_t i) {
+            std::inplace_merge(bounds[2 * i], bounds[2 * i + 1], bounds[2 * i + 2], compare);
+        });
+
+        std::vector<It> merged;
+        merged.reserve(bounds.size() / 2 + 1);
+        for (size_t i = 0; i < bounds.size(); i += 2)
+            merged.push_back(bounds[i]);
+        if (merged.back() != last)
+            merged.push_back(last);
+        bounds = std::move(merged);
+    }
+}
+
+template <typename It>
+void sort_optionals(
+    const It first, const It last, const null_order order, const size_t concurrency)
+{
+    if constexpr (use_radix_sort_v<It>)
+    {
+        using value_type = std::remove_const_t<optional_value_type<It>>;
+
+        const auto size = static_cast<size_t>(last - first);
+        // Default-initialized, as every element is written before it is read.
+        const std::unique_ptr<value_type[]> buffer{new value_type[2 * size]};
+        const auto values = buffer.get();
+        const auto scratch = values + size;
+
+        const auto count = copy_engaged(first, last, values);
+        parallel_sort(
+            values,
+            values + count,
+            compare_radix_keys,
+            [=](value_type* const chunk_first, value_type* const chunk_last) {
+                radix_sort(chunk_first, chunk_last, scratch + (chunk_first - values));
+            },
+            concurrency);
+        assign_sorted(first, last, values, count, order);
+    }
+    else
+    {
+        const auto [engaged_first, engaged_last] = partition_nulls(first, last, order);
+        parallel_sort(
+            engaged_first,
+            engaged_last,
+            compare_engaged,
+            [](const It chunk_first, const It chunk_last) {
+                std::sort(chunk_first, chunk_last, compare_engaged);
+            },
+            concurrency);
+    }
+}
+
+} // namespace details::sort_ns
+
+// Sorts a random access range of optionals in ascending order of their values with the
+// disengaged elements placed at the front or the back. The nulls are partitioned out before
+// sorting, so the engaged values are compared without checking for engagement. Integral and
+// floating point values are sorted with a radix sort, which orders floating point values by
+// their bits: -0.0 before +0.0, and NaNs at the ends according to their sign.
+template <typename RandomIt>
+void sort_optionals(
+    const RandomIt first, const RandomIt last, const null_order order = null_order::first)
+{
+    details::sort_ns::sort_optionals(first, last, order, 1);
+}
+
+// Same as sort_optionals but sorts chunks of the range on up to concurrency threads and then
+// merges them in parallel.
+template <typename RandomIt>
+void parallel_sort_optionals(
+    const RandomIt first,
+    const RandomIt last,
+    const null_order order = null_order::first,
+    const size_t concurrency = std::thread::hardware_concurrency())
+{
+    details::sort_ns::sort_optionals(first, last, order, concurrency);
+}
+
+} // namespace dze
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#include "atomic_optional.hpp"
+#include "details/check.hpp"
+#include "optional.hpp"
+
+namespace dze {
+
+namespace details::spsc_ring_ns {
+
+template <typename T, typename Policy, bool Padded>
+struct slot
+{
+    atomic_optional<T, Policy> value;
+};
+
+// Keeps neighbouring slots on separate cache lines, so that the producer writing one slot does
+// not contend with the consumer reading the previous one.
+template <typename T, typename Policy>
+struct alignas(64) slot<T, Policy, true>
+{
+    atomic_optional<T, Policy> value;
+};
+
+} // namespace details::spsc_ring_ns
+
+// A bounded single-producer single-consumer queue whose slots are atomic optionals. The
+// engagement of a slot tells whether it is occupied, so the producer and the consumer each
+// keep their position to themselves and share no index. The consumer finds a message ready
+// when its next slot is engaged and the producer finds space when its next slot is disengaged.
+//
+// Like atomic_optional, this requires a policy that stores the engagement state in the value,
+// and pushed values must not be the sentinel of the policy. With Padded, each slot has a cache
+// line of its own, which trades memory for less contention when the queue is nearly empty.
+template <typename T, typename Policy, bool Padded = false>
+class spsc_ring
+{
+    using slot = details::spsc_ring_ns::slot<T, Policy, Padded>;
+
+public:
+    using value_type = T;
+    using optional_type = optional<T, Policy>;
+
+    // The capacity is rounded up to a power of two.
+    explicit spsc_ring(const size_t capacity)
+        : m_mask{round_up(capacity) - 1}
+        , m_slots{std::make_unique<slot[]>(m_mask + 1)} {}
+
+    spsc_ring(const spsc_ring&) = delete;
+    spsc_ring& operator=(const spsc_ring&) = delete;
+
+    [[nodiscard]] size_t capacity() const noexcept { return m_mask + 1; }
+
+    // May only be called from the producer thread.
+    [[nodiscard]] bool try_push(const T& value) noexcept
+    {
+        const optional_type opt = value;
+        DZE_OPTIONAL_CHECK(opt.has_value());
+
+        auto& s = m_slots[m_producer.index & m_mask].value;
+        if (s.has_value(std::memory_order_acquire))
+            return false;
+
+        s.store(opt, std::memory_order_release);
+        ++m_producer.index;
+        return true;
+    }
+
+    // May only be called from the consumer thread.
+    [[nodiscard]] optional_type try_pop() noexcept
+    {
+        auto& s = m_slots[m_consumer.index & m_mask].value;
+        const optional_type result = s.load(std::memory_order_acquire);
+        if (result)
+        {
+            s.reset(std::memory_order_release);
+            ++m_consumer.index;
+        }
+
+        return result;
+    }
+
+private:
+    [[nodiscard]] static size_t round_up(const size_t capacity) noexcept
+    {
+        size_t result = 1;
+        while (result < capacity)
+            result *= 2;
+
+        return result;
+    }
+
+    // Each on a cache line of its own, which only its thread touches.
+    struct alignas(64) cursor
+    {
+        size_t index = 0;
+    };
+
+    const size_t m_mask;
+    const std::unique_ptr<slot[]> m_slots;
+    cursor m_producer;
+    cursor m_consumer;
+};
+
+template <typename T, typename Policy>
+using padded_spsc_ring = spsc_ring<T, Policy, true>;
+
+} // namespace dze
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <dze/requires.hpp>
+
+#include "bad_optional_access.hpp"
+#include "details/check.hpp"
+#include "nullopt.hpp"
+#include "optional_reference.hpp"
+#include "relocate.hpp"
+
+// DZE_OPTIONAL_AARCH64_HIGH_TAG_BITS selects whether tags use address bits 48 to 55 on
+// AArch64, which are zero in user space pointers unless the process asks for a larger
+// address space. It defaults to 0, so that only the alignment bits are used there. The top
+// byte is never used on AArch64: with top byte ignore it can hold a tag of the system, e.g.
+// of Android tagged pointers or of memory tagging, which must survive being stored and read
+// back.
+#ifndef DZE_OPTIONAL_AARCH64_HIGH_TAG_BITS
+#define DZE_OPTIONAL_AARCH64_HIGH_TAG_BITS 0
+#endif
+
+namespace dze {
+
+namespace details::tagged_reference_ns {
+
+inline constexpr unsigned pointer_bits = sizeof(uintptr_t) * 8;
+
+// The address bits below bit spare_high_end that tags may use. On x86-64 those are the bits
+// above the 48-bit virtual address space, which are zero in user space pointers unless the
+// process asks for a larger address space, which five-level paging on Linux leaves opt in.
+#if defined(__x86_64__) || defined(_M_X64)
+inline constexpr unsigned spare_high_bits = 16;
+inline constexpr unsigned spare_high_end = 64;
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && DZE_OPTIONAL_AARCH64_HIGH_TAG_BITS
+inline constexpr unsigned spare_high_bits = 8;
+inline constexpr unsigned spare_high_end = 56;
+#else
+inline constexpr unsigned spare_high_bits = 0;
+inline constexpr unsigned spare_high_end = pointer_bits;
+#endif
+
+[[nodiscard]] constexpr unsigned alignment_bits(size_t alignment) noexcept
+{
+    unsigned result = 0;
+    for (; alignment > 1; alignment /= 2)
+        ++result;
+
+    return result;
+}
+
+} // namespace details::tagged_reference_ns
+
+// An optional_reference that packs a tag of TagBits bits into the bits of its pointer that
+// are always zero: first the low bits that the alignment of T leaves free, then the high bits
+// above the virtual address space on x86-64, and on AArch64 if
+// DZE_OPTIONAL_AARCH64_HIGH_TAG_BITS allows it. It is the size of a pointer.
+//
+// The tag is independent of the reference: binding, rebinding and resetting keep the tag, and
+// a disengaged reference can have a tag. Copies copy both. Since the layout depends on the
+// alignment of T, T may be incomplete where the type is named, e.g. in a node of a graph
+// that refers to other nodes.
+template <typename T, unsigned TagBits>
+class tagged_optional_reference
+{
+    using bits_type = uintptr_t;
+
+public:
+    using value_type = T&;
+    using tag_type = uintptr_t;
+
+    static constexpr unsigned tag_bits = TagBits;
+    static constexpr tag_type max_tag = (tag_type{1} << TagBits) - 1;
+
+    static_assert(TagBits != 0 && TagBits < details::tagged_reference_ns::pointer_bits);
+
+    tagged_optional_reference() = default;
+
+    tagged_optional_reference(nullopt_t, const tag_type tag = 0) noexcept
+        : m_bits{encode_tag(tag)} {}
+
+    template <typename U = T,
+        DZE_REQUIRES(std::is_constructible_v<T&, U&>)>
+    tagged_optional_reference(U& u, const tag_type tag = 0) noexcept
+        : m_bits{encode_pointer(std::addressof(static_cast<T&>(u))) | encode_tag(tag)} {}
+
+    explicit tagged_optional_reference(
+        const optional_reference<T> ref, const tag_type tag = 0) noexcept
+        : m_bits{(ref ? encode_pointer(std::addressof(*ref)) : 0) | encode_tag(tag)} {}
+
+    // Keeps the tag.
+    tagged_optional_reference& operator=(nullopt_t) noexcept
+    {
+        m_bits &= ~pointer_mask();
+        return *this;
+    }
+
+    // Rebinds the reference and keeps the tag.
+    template <typename U = T,
+        DZE_REQUIRES(std::is_constructible_v<T&, U&> && std::is_convertible_v<U&, T&>)>
+    tagged_optional_reference& operator=(U& u) noexcept
+    {
+        m_bits = (m_bits & ~pointer_mask()) |
+            encode_pointer(std::addressof(static_cast<T&>(u)));
+        return *this;
+    }
+
+    template <typename U = T>
+    tagged_optional_reference& emplace(U& u) noexcept
+    {
+        return *this = u;
+    }
+
+    // Keeps the tag.
+    void reset() noexcept { *this = nullopt; }
+
+    void swap(tagged_optional_reference& other) noexcept
+    {
+        const auto backup = m_bits;
+        m_bits = other.m_bits;
+        other.m_bits = backup;
+    }
+
+    T* operator->() const noexcept
+    {
+        DZE_OPTIONAL_CHECK(has_value());
+
+        return pointer();
+    }
+
+    T& operator*() const noexcept { return *operator->(); }
+
+    [[nodiscard]] bool has_value() const noexcept { return (m_bits & pointer_mask()) != 0; }
+
+    explicit operator bool() const noexcept { return has_value(); }
+
+    [[nodiscard]] T& value() const
+    {
+        if (!has_value())
+            details::bad_optional_access_failure();
+
+        return *pointer();
+    }
+
+    [[nodiscard]] T& value_unchecked() const noexcept { return **this; }
+
+    template <typename U>
+    [[nodiscard]] T value_or(U&& u) const
+    {
+        static_assert(std::is_copy_constructible_v<T>);
+        static_assert(std::is_convertible_v<U&&, T>);
+
+        return has_value() ? **this : static_cast<T>(std::forward<U>(u));
+    }
+
+    [[nodiscard]] tag_type tag() const noexcept
+    {
+        tag_type result = m_bits & low_mask();
+        if constexpr (high_bits() != 0)
+            result |= ((m_bits >> high_shift()) & high_mask()) << low_bits();
+
+        return result;
+    }
+
+    void set_tag(const tag_type tag) noexcept
+    {
+        m_bits = (m_bits & pointer_mask()) | encode_tag(tag);
+    }
+
+    // The reference without its tag.
+    [[nodiscard]] optional_reference<T> reference() const noexcept
+    {
+        return has_value() ? optional_reference<T>{*pointer()} : optional_reference<T>{};
+    }
+
+private:
+    // Functions rather than constants, so that they are only evaluated once T is complete.
+    [[nodiscard]] static constexpr unsigned low_bits() noexcept
+    {
+        const unsigned available = details::tagged_reference_ns::alignment_bits(alignof(T));
+        return TagBits < available ? TagBits : available;
+    }
+
+    [[nodiscard]] static constexpr unsigned high_bits() noexcept
+    {
+        static_assert(
+            TagBits - low_bits() <= details::tagged_reference_ns::spare_high_bits,
+            "The tag does not fit in the spare bits of a pointer to T.");
+
+        return TagBits - low_bits();
+    }
+
+    [[nodiscard]] static constexpr unsigned high_shift() noexcept
+    {
+        return details::tagged_reference_ns::spare_high_end - high_bits();
+    }
+
+    [[nodiscard]] static constexpr bits_type low_mask() noexcept
+    {
+        return (bits_type{1} << low_bits()) - 1;
+    }
+
+    // The high part of the tag, shifted down to bit 0.
+    [[nodiscard]] static constexpr bits_type high_mask() noexcept
+    {
+        return (bits_type{1} << high_bits()) - 1;
+    }
+
+    [[nodiscard]] static constexpr bits_type pointer_mask() noexcept
+    {
+        bits_type result = ~low_mask();
+        if constexpr (high_bits() != 0)
+            result &= ~(high_mask() << high_shift());
+
+        return result;
+    }
+
+    [[nodiscard]] static bits_type encode_pointer(T* const p) noexcept
+    {
+        const auto bits = reinterpret_cast<bits_type>(p);
+        DZE_OPTIONAL_CHECK((bits & ~pointer_mask()) == 0);
+
+        return bits;
+    }
+
+    [[nodiscard]] static bits_type encode_tag(const tag_type tag) noexcept
+    {
+        DZE_OPTIONAL_CHECK(tag <= max_tag);
+
+        bits_type result = tag & low_mask();
+        if constexpr (high_bits() != 0)
+            result |= (tag >> low_bits()) << high_shift();
+
+        return result;
+    }
+
+    [[nodiscard]] T* pointer() const noexcept
+    {
+        return reinterpret_cast<T*>(m_bits & pointer_mask());
+    }
+
+    bits_type m_bits = 0;
+};
+
+template <typename T, unsigned TagBits>
+struct is_trivially_relocatable<tagged_optional_reference<T, TagBits>> : std::true_type {};
+
+// Comparisons with nullopt ignore the tag.
+
+template <typename T, unsigned TagBits>
+[[nodiscard]] bool operator==(
+    const tagged_optional_reference<T, TagBits>& lhs, nullopt_t) noexcept
+{
+    return !lhs;
+}
+
+template <typename T, unsigned TagBits>
+[[nodiscard]] bool operator==(
+    nullopt_t, const tagged_optional_reference<T, TagBits>& rhs) noexcept
+{
+    return !rhs;
+}
+
+template <typename T, unsigned TagBits>
+[[nodiscard]] bool operator!=(
+    const tagged_optional_reference<T, TagBits>& lhs, nullopt_t) noexcept
+{
+    return static_cast<bool>(lhs);
+}
+
+template <typename T, unsigned TagBits>
+[[nodiscard]] bool operator!=(
+    nullopt_t, const tagged_optional_reference<T, TagBits>& rhs) noexcept
+{
+    return static_cast<bool>(rhs);
+}
+
+template <typename T, unsigned TagBits>
+void swap(
+    tagged_optional_reference<T, TagBits>& lhs,
+    tagged_optional_reference<T, TagBits>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace dze
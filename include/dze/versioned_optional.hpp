@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include <dze/requires.hpp>
+
+#include "nullopt.hpp"
+#include "optional.hpp"
+
+namespace dze {
+
+// An optional for large trivially copyable values that one thread writes and any number of
+// threads read, protected by a sequence lock. Readers copy the optional optimistically and
+// retry if a write overlapped the copy, so reading takes no lock and writes nothing to shared
+// memory. Writing is wait-free, but the writer must be unique, which is up to the caller.
+//
+// The optional, including its engagement state, is stored as words that are accessed
+// atomically, which makes the optimistic copy of readers well-defined. A reader that loads a
+// word of a write acquires the odd sequence number stored before it, so it then fails to
+// validate. On x86 these are plain loads and stores.
+template <typename T, typename Policy = details::optional_ns::default_policy>
+class versioned_optional
+{
+public:
+    using value_type = optional<T, Policy>;
+
+private:
+    static_assert(std::is_trivially_copyable_v<value_type>);
+
+    static constexpr size_t word_count = (sizeof(value_type) + 7) / 8;
+
+public:
+    versioned_optional() noexcept
+        : versioned_optional{value_type{}} {}
+
+    versioned_optional(nullopt_t) noexcept
+        : versioned_optional{} {}
+
+    versioned_optional(const value_type& value) noexcept { write(value); }
+
+    versioned_optional(const versioned_optional&) = delete;
+    versioned_optional& operator=(const versioned_optional&) = delete;
+
+    // May be called from any thread.
+    [[nodiscard]] value_type load() const noexcept
+    {
+        value_type result;
+        while (!try_load(result)) {}
+        return result;
+    }
+
+    // Copies the optional into result unless a write is in progress or overlaps the copy, and
+    // returns whether it did. May be called from any thread.
+    [[nodiscard]] bool try_load(value_type& result) const noexcept
+    {
+        const uint64_t before = m_sequence.load(std::memory_order_acquire);
+        if (before % 2 != 0)
+            return false;
+
+        read(result);
+        return m_sequence.load(std::memory_order_relaxed) == before;
+    }
+
+    [[nodiscard]] bool has_value() const noexcept { return load().has_value(); }
+
+    // Incremented by two on every write.
+    [[nodiscard]] uint64_t version() const noexcept
+    {
+        return m_sequence.load(std::memory_order_acquire);
+    }
+
+    // The writing operations may only be called from the writer thread.
+
+    void store(const value_type& value) noexcept
+    {
+        const uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        write(value);
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    template <typename... Args,
+        DZE_REQUIRES(std::is_constructible_v<T, Args&&...>)>
+    void emplace(Args&&... args)
+    {
+        store(value_type{std::in_place, std::forward<Args>(args)...});
+    }
+
+    void reset() noexcept { store(value_type{}); }
+
+private:
+    void write(const value_type& value) noexcept
+    {
+        const auto* const bytes = reinterpret_cast<const std::byte*>(&value);
+        for (size_t i = 0; i != word_count; ++i)
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, bytes + i * 8, chunk_size(i));
+            m_words[i].store(word, std::memory_order_release);
+        }
+    }
+
+    void read(value_type& result) const noexcept
+    {
+        auto* const bytes = reinterpret_cast<std::byte*>(&result);
+        for (size_t i = 0; i != word_count; ++i)
+        {
+            const uint64_t word = m_words[i].load(std::memory_order_acquire);
+            std::memcpy(bytes + i * 8, &word, chunk_size(i));
+        }
+    }
+
+    [[nodiscard]] static constexpr size_t chunk_size(const size_t i) noexcept
+    {
+        return i + 1 == word_count ? sizeof(value_type) - i * 8 : 8;
+    }
+
+    // The sequence is odd while a write is in progress.
+    alignas(64) std::atomic<uint64_t> m_sequence{0};
+    std::atomic<uint64_t> m_words[word_count];
+};
+
+} // namespace dze
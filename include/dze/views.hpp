@@ -0,0 +1,530 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#if __has_include(<ranges>)
+#include <ranges>
+#endif
+
+#include "details/bit.hpp"
+#include "details/bulk.hpp"
+
+namespace dze {
+
+namespace details::views_ns {
+
+#ifdef __cpp_lib_ranges
+using view_base = std::ranges::view_base;
+#else
+struct view_base {};
+#endif
+
+// Refers to lvalue ranges and takes ownership of rvalue ones so that views over temporaries
+// do not dangle.
+template <typename R>
+class range_holder
+{
+public:
+    constexpr explicit range_holder(R& r) noexcept
+        : m_range{std::addressof(r)} {}
+
+    [[nodiscard]] constexpr R& get() const noexcept { return *m_range; }
+
+private:
+    R* m_range;
+};
+
+template <typename R>
+class range_holder<R&&>
+{
+public:
+    constexpr explicit range_holder(R&& r)
+        : m_range{std::move(r)} {}
+
+    [[nodiscard]] constexpr R& get() noexcept { return m_range; }
+
+    [[nodiscard]] constexpr const R& get() const noexcept { return m_range; }
+
+private:
+    R m_range;
+};
+
+template <typename R>
+using holder_t = std::conditional_t<
+    std::is_lvalue_reference_v<R>,
+    range_holder<std::remove_reference_t<R>>,
+    range_holder<std::remove_cv_t<std::remove_reference_t<R>>&&>>;
+
+template <typename R>
+using iterator_t = decltype(std::begin(std::declval<R&>()));
+
+template <typename R>
+using sentinel_t = decltype(std::end(std::declval<R&>()));
+
+// Ranges with data() and size() are scanned block by block with engagement masks.
+template <typename R, typename = void>
+constexpr bool is_contiguous_v = false;
+
+template <typename R>
+constexpr bool is_contiguous_v<
+    R,
+    std::void_t<
+        decltype(std::data(std::declval<R&>())),
+        decltype(std::size(std::declval<R&>()))>> =
+    std::is_pointer_v<decltype(std::data(std::declval<R&>()))>;
+
+// Compares equal to an iterator of the views in this file once it is exhausted.
+struct end_sentinel {};
+
+// Iterates over the engaged elements of a contiguous range of optionals. The engagement of
+// each block of optional_ns::block_size elements is computed at once into a mask and the
+// iterator then jumps from one set bit to the next.
+template <typename Opt, bool Enumerate>
+class block_iterator
+{
+    using element_reference = decltype(*std::declval<Opt&>());
+
+public:
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<
+        Enumerate,
+        std::pair<size_t, element_reference>,
+        element_reference>;
+    using value_type = std::conditional_t<
+        Enumerate,
+        reference,
+        std::remove_cv_t<std::remove_reference_t<element_reference>>>;
+    // Enumerating yields pairs by value, which legacy forward iterators may not.
+    using iterator_category = std::conditional_t<
+        Enumerate,
+        std::input_iterator_tag,
+        std::forward_iterator_tag>;
+    using iterator_concept = std::forward_iterator_tag;
+    using pointer = void;
+
+    block_iterator() = default;
+
+    block_iterator(Opt* const first, Opt* const last) noexcept
+        : m_first{first}
+        , m_block{first}
+        , m_last{last}
+    {
+        load_block();
+        if (m_mask == 0)
+            next_block();
+    }
+
+    [[nodiscard]] reference operator*() const
+    {
+        const auto pos = position();
+        if constexpr (Enumerate)
+            return {static_cast<size_t>(pos - m_first), **pos};
+        else
+            return **pos;
+    }
+
+    block_iterator& operator++() noexcept
+    {
+        m_mask &= m_mask - 1;
+        if (m_mask == 0)
+            next_block();
+
+        return *this;
+    }
+
+    block_iterator operator++(int) noexcept
+    {
+        auto copy = *this;
+        ++*this;
+        return copy;
+    }
+
+    [[nodiscard]] friend bool operator==(
+        const block_iterator& lhs, const block_iterator& rhs) noexcept
+    {
+        return lhs.position() == rhs.position();
+    }
+
+    [[nodiscard]] friend bool operator==(const block_iterator& it, end_sentinel) noexcept
+    {
+        return it.m_mask == 0;
+    }
+
+#ifndef __cpp_impl_three_way_comparison
+    [[nodiscard]] friend bool operator!=(
+        const block_iterator& lhs, const block_iterator& rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+
+    [[nodiscard]] friend bool operator!=(const block_iterator& it, end_sentinel) noexcept
+    {
+        return it.m_mask != 0;
+    }
+
+    [[nodiscard]] friend bool operator==(end_sentinel, const block_iterator& it) noexcept
+    {
+        return it.m_mask == 0;
+    }
+
+    [[nodiscard]] friend bool operator!=(end_sentinel, const block_iterator& it) noexcept
+    {
+        return it.m_mask != 0;
+    }
+#endif
+
+private:
+    Opt* m_first = nullptr;
+    Opt* m_block = nullptr;
+    Opt* m_last = nullptr;
+    uint64_t m_mask = 0;
+
+    [[nodiscard]] Opt* position() const noexcept
+    {
+        return m_mask == 0 ? m_last : m_block + countr_zero(m_mask);
+    }
+
+    void load_block() noexcept
+    {
+        using optional_ns::block_size;
+
+        const auto remaining = static_cast<size_t>(m_last - m_block);
+        m_mask = optional_ns::engagement_mask(
+            m_block, remaining < block_size ? remaining : block_size);
+    }
+
+    void next_block() noexcept
+    {
+        while (m_mask == 0 &&
+            static_cast<size_t>(m_last - m_block) > optional_ns::block_size)
+        {
+            m_block += optional_ns::block_size;
+            load_block();
+        }
+    }
+};
+
+// Iterates over the engaged elements of any other range of optionals.
+template <typename It, typename Sent, bool Enumerate>
+class skip_iterator
+{
+    using element_reference = decltype(**std::declval<It&>());
+
+public:
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<
+        Enumerate,
+        std::pair<size_t, element_reference>,
+        element_reference>;
+    using value_type = std::conditional_t<
+        Enumerate,
+        reference,
+        std::remove_cv_t<std::remove_reference_t<element_reference>>>;
+    // Enumerating yields pairs by value, which legacy forward iterators may not.
+    using iterator_category = std::conditional_t<
+        Enumerate,
+        std::input_iterator_tag,
+        std::forward_iterator_tag>;
+    using iterator_concept = std::forward_iterator_tag;
+    using pointer = void;
+
+    skip_iterator() = default;
+
+    skip_iterator(It it, Sent last)
+        : m_it{std::move(it)}
+        , m_last{std::move(last)}
+    {
+        skip();
+    }
+
+    [[nodiscard]] reference operator*() const
+    {
+        if constexpr (Enumerate)
+            return {m_index, **m_it};
+        else
+            return **m_it;
+    }
+
+    skip_iterator& operator++()
+    {
+        ++m_it;
+        ++m_index;
+        skip();
+        return *this;
+    }
+
+    skip_iterator operator++(int)
+    {
+        auto copy = *this;
+        ++*this;
+        return copy;
+    }
+
+    [[nodiscard]] friend bool operator==(const skip_iterator& lhs, const skip_iterator& rhs)
+    {
+        return lhs.m_it == rhs.m_it;
+    }
+
+    [[nodiscard]] friend bool operator==(const skip_iterator& it, end_sentinel)
+    {
+        return it.m_it == it.m_last;
+    }
+
+#ifndef __cpp_impl_three_way_comparison
+    [[nodiscard]] friend bool operator!=(const skip_iterator& lhs, const skip_iterator& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    [[nodiscard]] friend bool operator!=(const skip_iterator& it, end_sentinel)
+    {
+        return !(it.m_it == it.m_last);
+    }
+
+    [[nodiscard]] friend bool operator==(end_sentinel, const skip_iterator& it)
+    {
+        return it.m_it == it.m_last;
+    }
+
+    [[nodiscard]] friend bool operator!=(end_sentinel, const skip_iterator& it)
+    {
+        return !(it.m_it == it.m_last);
+    }
+#endif
+
+private:
+    It m_it{};
+    Sent m_last{};
+    size_t m_index = 0;
+
+    void skip()
+    {
+        for (; !(m_it == m_last) && !(*m_it).has_value(); ++m_it)
+            ++m_index;
+    }
+};
+
+// Lazily yields the values of the engaged optionals of R or, with Enumerate, pairs of their
+// indices and values.
+template <typename R, bool Enumerate>
+class engaged_view : public view_base
+{
+public:
+    constexpr explicit engaged_view(R&& r)
+        : m_range{std::forward<R>(r)} {}
+
+    [[nodiscard]] auto begin() { return make_begin(m_range.get()); }
+
+    [[nodiscard]] auto begin() const { return make_begin(m_range.get()); }
+
+    [[nodiscard]] constexpr end_sentinel end() const noexcept { return {}; }
+
+private:
+    holder_t<R> m_range;
+
+    template <typename Range>
+    [[nodiscard]] static auto make_begin(Range& range)
+    {
+        if constexpr (is_contiguous_v<Range>)
+        {
+            using opt_type = std::remove_pointer_t<decltype(std::data(range))>;
+
+            const auto first = std::data(range);
+            return block_iterator<opt_type, Enumerate>{first, first + std::size(range)};
+        }
+        else
+        {
+            return skip_iterator<iterator_t<Range>, sentinel_t<Range>, Enumerate>{
+                std::begin(range), std::end(range)};
+        }
+    }
+};
+
+// Yields the value of each optional of R, or the default value when it is disengaged.
+template <typename R>
+class values_or_view : public view_base
+{
+    using range_iterator = iterator_t<std::remove_reference_t<R>>;
+    using range_sentinel = sentinel_t<std::remove_reference_t<R>>;
+    using opt_type = std::remove_reference_t<decltype(*std::declval<range_iterator&>())>;
+
+public:
+    using value_type = std::remove_cv_t<
+        std::remove_reference_t<typename std::remove_cv_t<opt_type>::value_type>>;
+
+    template <typename It, typename Sent>
+    class basic_iterator
+    {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = values_or_view::value_type;
+        using reference = value_type;
+        // Values are yielded by value, which legacy forward iterators may not.
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::forward_iterator_tag;
+        using pointer = void;
+
+        basic_iterator() = default;
+
+        basic_iterator(It it, Sent last, const value_type* const default_value)
+            : m_it{std::move(it)}
+            , m_last{std::move(last)}
+            , m_default{default_value} {}
+
+        [[nodiscard]] value_type operator*() const
+        {
+            const auto& opt = *m_it;
+            return opt.has_value() ? static_cast<value_type>(*opt) : *m_default;
+        }
+
+        basic_iterator& operator++()
+        {
+            ++m_it;
+            return *this;
+        }
+
+        basic_iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        [[nodiscard]] friend bool operator==(
+            const basic_iterator& lhs, const basic_iterator& rhs)
+        {
+            return lhs.m_it == rhs.m_it;
+        }
+
+        [[nodiscard]] friend bool operator==(const basic_iterator& it, end_sentinel)
+        {
+            return it.m_it == it.m_last;
+        }
+
+#ifndef __cpp_impl_three_way_comparison
+        [[nodiscard]] friend bool operator!=(
+            const basic_iterator& lhs, const basic_iterator& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        [[nodiscard]] friend bool operator!=(const basic_iterator& it, end_sentinel)
+        {
+            return !(it.m_it == it.m_last);
+        }
+
+        [[nodiscard]] friend bool operator==(end_sentinel, const basic_iterator& it)
+        {
+            return it.m_it == it.m_last;
+        }
+
+        [[nodiscard]] friend bool operator!=(end_sentinel, const basic_iterator& it)
+        {
+            return !(it.m_it == it.m_last);
+        }
+#endif
+
+    private:
+        It m_it{};
+        Sent m_last{};
+        const value_type* m_default = nullptr;
+    };
+
+    using iterator = basic_iterator<range_iterator, range_sentinel>;
+
+    template <typename U>
+    constexpr values_or_view(R&& r, U&& default_value)
+        : m_range{std::forward<R>(r)}
+        , m_default(std::forward<U>(default_value)) {}
+
+    [[nodiscard]] auto begin() { return make_begin(m_range.get(), m_default); }
+
+    [[nodiscard]] auto begin() const { return make_begin(m_range.get(), m_default); }
+
+    [[nodiscard]] constexpr end_sentinel end() const noexcept { return {}; }
+
+private:
+    holder_t<R> m_range;
+    value_type m_default;
+
+    template <typename Range>
+    [[nodiscard]] static auto make_begin(Range& range, const value_type& default_value)
+    {
+        return basic_iterator<iterator_t<Range>, sentinel_t<Range>>{
+            std::begin(range), std::end(range), std::addressof(default_value)};
+    }
+};
+
+template <bool Enumerate>
+struct engaged_fn
+{
+    template <typename R>
+    [[nodiscard]] constexpr auto operator()(R&& r) const
+    {
+        return engaged_view<R, Enumerate>{std::forward<R>(r)};
+    }
+
+    template <typename R>
+    [[nodiscard]] friend constexpr auto operator|(R&& r, const engaged_fn& fn)
+    {
+        return fn(std::forward<R>(r));
+    }
+};
+
+template <typename D>
+struct values_or_closure
+{
+    D default_value;
+
+    template <typename R>
+    [[nodiscard]] friend constexpr auto operator|(R&& r, values_or_closure&& closure)
+    {
+        return values_or_view<R>{std::forward<R>(r), std::move(closure.default_value)};
+    }
+
+    template <typename R>
+    [[nodiscard]] friend constexpr auto operator|(R&& r, const values_or_closure& closure)
+    {
+        return values_or_view<R>{std::forward<R>(r), closure.default_value};
+    }
+};
+
+struct values_or_fn
+{
+    template <typename R, typename D>
+    [[nodiscard]] constexpr auto operator()(R&& r, D&& default_value) const
+    {
+        return values_or_view<R>{std::forward<R>(r), std::forward<D>(default_value)};
+    }
+
+    template <typename D>
+    [[nodiscard]] constexpr auto operator()(D&& default_value) const
+    {
+        return values_or_closure<std::decay_t<D>>{std::forward<D>(default_value)};
+    }
+};
+
+} // namespace details::views_ns
+
+// Lazy, non-allocating adaptors over ranges of dze::optional and dze::optional_reference.
+// Lvalue ranges are referred to and rvalue ones are moved into the view. They compose with
+// the pipe syntax, e.g. `opts | dze::views::engaged`, and with the standard range adaptors
+// when those are available.
+namespace views {
+
+// Values of the engaged elements.
+inline constexpr details::views_ns::engaged_fn<false> engaged{};
+
+// Pairs of the indices of the engaged elements in the underlying range and their values.
+inline constexpr details::views_ns::engaged_fn<true> enumerate_engaged{};
+
+// Value of each element, or the given default for the disengaged ones.
+inline constexpr details::views_ns::values_or_fn values_or{};
+
+} // namespace views
+
+} // namespace dze
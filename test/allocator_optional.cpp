@@ -0,0 +1,181 @@
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <dze/allocator_optional.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+class counting_resource : public std::pmr::memory_resource
+{
+public:
+    size_t allocations = 0;
+
+private:
+    void* do_allocate(const size_t bytes, const size_t alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* const ptr, const size_t bytes, const size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+// Takes the allocator as the last constructor argument.
+struct trailing
+{
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    int value;
+    allocator_type alloc;
+    int* destroyed = nullptr;
+
+    trailing(const int v, int* const d, const allocator_type& a)
+        : value{v}
+        , alloc{a}
+        , destroyed{d} {}
+
+    trailing(const trailing&) = delete;
+
+    ~trailing()
+    {
+        if (destroyed)
+            ++*destroyed;
+    }
+};
+
+constexpr std::string_view long_string =
+    "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa";
+
+} // namespace
+
+TEST_CASE("Uses-allocator construction", "[allocator_optional.construct]")
+{
+    counting_resource resource;
+    const std::pmr::polymorphic_allocator<std::byte> alloc{&resource};
+
+    SECTION("leading allocator")
+    {
+        dze::pmr::optional<std::pmr::string> o{alloc};
+        CHECK(!o);
+        CHECK(o.get_allocator() == alloc);
+
+        o.emplace(long_string);
+        REQUIRE(o);
+        CHECK(o->get_allocator() == alloc);
+        CHECK(resource.allocations == 1);
+
+        o.reset();
+        o = long_string;
+        CHECK(o == long_string);
+        CHECK(o->get_allocator() == alloc);
+        CHECK(resource.allocations == 2);
+
+        dze::pmr::optional<std::pmr::string> in_place{
+            std::allocator_arg, alloc, std::in_place, 100, 'b'};
+        CHECK(in_place->get_allocator() == alloc);
+    }
+
+    SECTION("trailing allocator")
+    {
+        int destroyed = 0;
+        dze::pmr::optional<trailing> o{alloc};
+        o.emplace(1, &destroyed);
+        CHECK(o->alloc == alloc);
+        o.reset();
+        CHECK(destroyed == 1);
+    }
+
+    SECTION("no allocator")
+    {
+        dze::pmr::optional<int> o{42, alloc};
+        CHECK(o == 42);
+    }
+
+    SECTION("std::allocator")
+    {
+        dze::allocator_optional<std::vector<int>, std::allocator<int>> o;
+        o.emplace(3, 1);
+        CHECK(o == std::vector<int>{1, 1, 1});
+    }
+}
+
+TEST_CASE("Allocator propagation", "[allocator_optional.propagate]")
+{
+    counting_resource resource1;
+    counting_resource resource2;
+    const std::pmr::polymorphic_allocator<std::byte> alloc1{&resource1};
+    const std::pmr::polymorphic_allocator<std::byte> alloc2{&resource2};
+
+    const dze::pmr::optional<std::pmr::string> source{long_string, alloc1};
+
+    SECTION("copy construction")
+    {
+        const auto copy = source;
+        CHECK(copy == source);
+        CHECK(copy.get_allocator().resource() == std::pmr::get_default_resource());
+
+        const dze::pmr::optional<std::pmr::string> extended{
+            std::allocator_arg, alloc2, source};
+        CHECK(extended->get_allocator() == alloc2);
+    }
+
+    SECTION("copy assignment")
+    {
+        dze::pmr::optional<std::pmr::string> o{alloc2};
+        o = source;
+        CHECK(o == source);
+        CHECK(o.get_allocator() == alloc2);
+        CHECK(o->get_allocator() == alloc2);
+    }
+
+    SECTION("move")
+    {
+        dze::pmr::optional<std::pmr::string> moved{std::allocator_arg, alloc1, source};
+        const auto allocations = resource1.allocations;
+        dze::pmr::optional<std::pmr::string> o{alloc1};
+        o = std::move(moved);
+        CHECK(o == source);
+        CHECK(resource1.allocations == allocations);
+
+        dze::pmr::optional<std::pmr::string> other{alloc2};
+        other = std::move(o);
+        CHECK(other == source);
+        CHECK(other->get_allocator() == alloc2);
+        CHECK(resource2.allocations == 1);
+
+        const dze::pmr::optional<std::pmr::string> constructed{std::move(other)};
+        CHECK(constructed.get_allocator() == alloc2);
+        CHECK(constructed == source);
+    }
+}
+
+TEST_CASE("Release without destruction", "[allocator_optional.release]")
+{
+    std::pmr::monotonic_buffer_resource arena;
+    int destroyed = 0;
+
+    {
+        dze::pmr::optional<trailing> o{&arena};
+        o.emplace(1, &destroyed);
+        o.release();
+        CHECK(!o);
+        o.release();
+    }
+    CHECK(destroyed == 0);
+
+}
@@ -0,0 +1,155 @@
+#include "optional.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <dze/atomic_optional.hpp>
+
+#include <catch2/catch.hpp>
+
+TEMPLATE_TEST_CASE(
+    "Atomic optional",
+    "[atomic_optional]",
+    (dze::sentinel<int32_t, -1>),
+    (dze::sentinel<uint8_t, 0xFF>),
+    (dze::sentinel<int64_t, -1>))
+{
+    using value_type = typename TestType::value_type;
+
+    dze::atomic_optional<value_type, typename TestType::policy_type> o;
+    STATIC_REQUIRE(decltype(o)::is_always_lock_free);
+
+    REQUIRE(!o.has_value());
+    REQUIRE(o.load() == dze::nullopt);
+
+    SECTION("Store and load")
+    {
+        o.store(TestType{value_type{1}});
+        REQUIRE(o.load() == value_type{1});
+        o.reset();
+        REQUIRE(!o.has_value());
+    }
+
+    SECTION("Exchange and take")
+    {
+        REQUIRE(o.exchange(value_type{1}) == dze::nullopt);
+        REQUIRE(o.exchange(value_type{2}) == value_type{1});
+        REQUIRE(o.take() == value_type{2});
+        REQUIRE(!o.has_value());
+        REQUIRE(o.take() == dze::nullopt);
+    }
+
+    SECTION("Try emplace")
+    {
+        REQUIRE(o.try_emplace(value_type{1}));
+        REQUIRE(!o.try_emplace(value_type{2}));
+        REQUIRE(o.load() == value_type{1});
+    }
+
+    SECTION("Compare exchange")
+    {
+        TestType expected = value_type{1};
+        REQUIRE(!o.compare_exchange_strong(expected, value_type{2}));
+        REQUIRE(expected == dze::nullopt);
+        REQUIRE(o.compare_exchange_strong(expected, value_type{2}));
+        REQUIRE(o.load() == value_type{2});
+
+        expected = value_type{2};
+        while (!o.compare_exchange_weak(expected, value_type{3}, std::memory_order_acq_rel))
+            REQUIRE(expected == value_type{2});
+        REQUIRE(o.load() == value_type{3});
+    }
+}
+
+TEST_CASE("Atomic optional of a custom policy", "[atomic_optional]")
+{
+    dze::atomic_optional<int32_t, dze::test::ff_policy<4>> o{42};
+    REQUIRE(o.load() == 42);
+    REQUIRE(o.take() == 42);
+    REQUIRE(!o.has_value());
+}
+
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+namespace {
+
+struct wide
+{
+    int64_t a;
+    int64_t b;
+};
+
+bool operator==(const wide lhs, const wide rhs) { return lhs.a == rhs.a && lhs.b == rhs.b; }
+
+} // namespace
+
+TEST_CASE("Atomic optional of 16 bytes", "[atomic_optional]")
+{
+    dze::atomic_optional<wide, dze::test::ff_policy<16>> o;
+    STATIC_REQUIRE(decltype(o)::is_always_lock_free);
+
+    REQUIRE(!o.has_value());
+    REQUIRE(o.try_emplace(wide{1, 2}));
+    REQUIRE(!o.try_emplace(wide{3, 4}));
+    REQUIRE(o.load() == wide{1, 2});
+
+    dze::test::ff_sentinel<wide> expected = wide{1, 2};
+    REQUIRE(o.compare_exchange_strong(expected, wide{5, 6}));
+    REQUIRE(o.exchange(wide{7, 8}) == wide{5, 6});
+    REQUIRE(o.take() == wide{7, 8});
+    REQUIRE(!o.has_value());
+}
+#endif
+
+TEST_CASE("Atomic optional handoff", "[atomic_optional]")
+{
+    constexpr int64_t count = 10'000;
+
+    dze::atomic_optional<int64_t, dze::test::ff_policy<8>> slot;
+    std::atomic<int64_t> sum{0};
+
+    const auto consume = [&] {
+        for (int64_t received = 0; received != count / 2;)
+        {
+            if (const auto value = slot.take(std::memory_order_acquire))
+            {
+                sum.fetch_add(*value, std::memory_order_relaxed);
+                ++received;
+            }
+            else
+                std::this_thread::yield();
+        }
+    };
+
+    std::vector<std::thread> consumers;
+    consumers.emplace_back(consume);
+    consumers.emplace_back(consume);
+    for (int64_t i = 1; i <= count;)
+    {
+        if (slot.try_emplace(i, std::memory_order_release))
+            ++i;
+        else
+            std::this_thread::yield();
+    }
+
+    for (auto& consumer : consumers)
+        consumer.join();
+
+    REQUIRE(sum.load() == count * (count + 1) / 2);
+}
+
+#if defined(__cpp_lib_atomic_wait)
+TEST_CASE("Atomic optional wait", "[atomic_optional]")
+{
+    dze::atomic_optional<int32_t, dze::test::ff_policy<4>> o;
+    std::thread producer{[&] {
+        o.store(42);
+        o.notify_one();
+    }};
+
+    o.wait(dze::nullopt);
+    REQUIRE(o.load() == 42);
+    producer.join();
+}
+#endif
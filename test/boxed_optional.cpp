@@ -0,0 +1,202 @@
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <dze/boxed_optional.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+struct large
+{
+    std::array<char, 1024> bytes{};
+    std::string name;
+
+    explicit large(std::string n)
+        : name{std::move(n)} {}
+
+    friend bool operator==(const large& lhs, const large& rhs) { return lhs.name == rhs.name; }
+};
+
+} // namespace
+
+TEST_CASE("Boxed optional size", "[boxed_optional.size]")
+{
+    STATIC_REQUIRE(sizeof(dze::boxed_optional<large>) == sizeof(void*));
+    STATIC_REQUIRE(dze::is_trivially_relocatable_v<dze::boxed_optional<std::string>>);
+}
+
+TEST_CASE("Boxed optional", "[boxed_optional.basic]")
+{
+    dze::boxed_optional<large> o1;
+    CHECK(!o1);
+    CHECK(o1 == dze::nullopt);
+    CHECK_THROWS_AS(o1.value(), dze::bad_optional_access);
+
+    o1.emplace("a");
+    REQUIRE(o1);
+    CHECK(o1->name == "a");
+
+    const auto* const address = &*o1;
+    o1 = large{"b"};
+    CHECK(o1.value().name == "b");
+    CHECK(&*o1 == address);
+
+    auto o2 = o1;
+    REQUIRE(o2);
+    CHECK(&*o2 != &*o1);
+    CHECK(o1 == o2);
+
+    auto o3 = std::move(o1);
+    CHECK(!o1);
+    CHECK(&*o3 == address);
+
+    o1 = std::move(o3);
+    CHECK(&*o1 == address);
+    o2 = o3;
+    CHECK(!o2);
+
+    swap(o1, o2);
+    CHECK(!o1);
+    CHECK(&*o2 == address);
+
+    o2.reset();
+    CHECK(!o2);
+
+    dze::boxed_optional<const std::string> c{"a"};
+    CHECK(c == "a");
+    c.emplace("b");
+    CHECK(c.value_or("c") == "b");
+    c = dze::nullopt;
+    CHECK(c.value_or("c") == "c");
+}
+
+TEST_CASE("Boxed optional relops", "[boxed_optional.relops]")
+{
+    const dze::boxed_optional<int> null;
+    const dze::boxed_optional<int> one = 1;
+    const dze::boxed_optional<long> two = 2L;
+
+    const std::vector<dze::optional<int>> reference = {{}, 1};
+    const std::vector<const dze::boxed_optional<int>*> boxed = {&null, &one};
+
+    for (size_t i = 0; i != boxed.size(); ++i)
+    {
+        for (size_t j = 0; j != boxed.size(); ++j)
+        {
+            const auto& l = *boxed[i];
+            const auto& r = *boxed[j];
+            CHECK((l == r) == (reference[i] == reference[j]));
+            CHECK((l != r) == (reference[i] != reference[j]));
+            CHECK((l < r) == (reference[i] < reference[j]));
+            CHECK((l > r) == (reference[i] > reference[j]));
+            CHECK((l <= r) == (reference[i] <= reference[j]));
+            CHECK((l >= r) == (reference[i] >= reference[j]));
+        }
+
+        for (const int v : {0, 1, 2})
+        {
+            const auto& l = *boxed[i];
+            CHECK((l == v) == (reference[i] == v));
+            CHECK((v != l) == (v != reference[i]));
+            CHECK((l < v) == (reference[i] < v));
+            CHECK((v < l) == (v < reference[i]));
+            CHECK((l >= v) == (reference[i] >= v));
+            CHECK((v >= l) == (v >= reference[i]));
+        }
+    }
+
+    CHECK(one < two);
+    CHECK(two > one);
+    CHECK(null < two);
+    CHECK(dze::nullopt <= null);
+    CHECK(one > dze::nullopt);
+}
+
+TEST_CASE("Boxed optional hash", "[boxed_optional.hash]")
+{
+    const dze::boxed_optional<std::string> o = "abc";
+    CHECK(dze::hash<dze::boxed_optional<std::string>>{}(o) == std::hash<std::string>{}("abc"));
+    CHECK(
+        dze::hash<dze::boxed_optional<std::string>>{}(dze::nullopt) ==
+        dze::hash<dze::optional<std::string>>{}(dze::nullopt));
+}
+
+TEST_CASE("Slab pool", "[boxed_optional.pool]")
+{
+    using pool = dze::slab_pool<int, 4>;
+
+    std::vector<void*> pointers;
+    for (int i = 0; i != 10; ++i)
+        pointers.push_back(pool::allocate());
+    for (auto* const ptr : pointers)
+        pool::deallocate(ptr);
+
+    // Memory is reused in LIFO order.
+    CHECK(pool::allocate() == pointers.back());
+    pool::deallocate(pointers.back());
+
+    std::vector<dze::boxed_optional<int, pool>> boxes(100);
+    std::thread thread{[&] {
+        for (int i = 0; i != 100; ++i)
+            boxes[static_cast<size_t>(i)] = i;
+    }};
+    thread.join();
+
+    for (int i = 0; i != 100; ++i)
+        CHECK(boxes[static_cast<size_t>(i)] == i);
+    boxes.clear();
+}
+
+// Destroyed after the thread locals of the main thread, which deallocates to the shared list.
+const dze::boxed_optional<int, dze::slab_pool<int, 4>> static_box = 1;
+
+TEST_CASE("Slab pool between a producer and a consumer", "[boxed_optional.pool]")
+{
+    using pool = dze::slab_pool<long, 8>;
+
+    constexpr size_t count = 100000;
+    constexpr size_t max_queued = 64;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<void*> queue;
+
+    // Memory freed by the consumer has to make its way back to the producer.
+    std::thread consumer{[&] {
+        std::vector<void*> batch;
+        for (size_t freed = 0; freed != count; freed += batch.size())
+        {
+            batch.clear();
+            {
+                std::unique_lock lock{mutex};
+                cv.wait(lock, [&] { return !queue.empty(); });
+                batch.swap(queue);
+            }
+            cv.notify_all();
+
+            for (void* const ptr : batch)
+                pool::deallocate(ptr);
+        }
+    }};
+
+    for (size_t i = 0; i != count; ++i)
+    {
+        void* const ptr = pool::allocate();
+        {
+            std::unique_lock lock{mutex};
+            cv.wait(lock, [&] { return queue.size() < max_queued; });
+            queue.push_back(ptr);
+        }
+        cv.notify_all();
+    }
+    consumer.join();
+
+    CHECK(static_box == 1);
+    CHECK(pool::slab_count() <= 32);
+}
@@ -0,0 +1,87 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <dze/concurrent_sentinel_map.hpp>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Concurrent sentinel map", "[concurrent_sentinel_map]")
+{
+    dze::concurrent_sentinel_map<uint64_t, uint32_t, ~uint64_t{0}, 0u> map;
+    REQUIRE(map.size() == 0);
+    REQUIRE(map.find(1) == dze::nullopt);
+
+    REQUIRE(map.insert(1, 10) == std::pair<uint32_t, bool>{10, true});
+    REQUIRE(map.insert(1, 11) == std::pair<uint32_t, bool>{10, false});
+    REQUIRE(map.find(1) == 10u);
+    REQUIRE(map.contains(1));
+    REQUIRE(!map.contains(2));
+    REQUIRE(map.size() == 1);
+
+    SECTION("Growth")
+    {
+        const size_t capacity = map.capacity();
+        for (uint64_t i = 2; i != 10000; ++i)
+            REQUIRE(map.insert(i, static_cast<uint32_t>(i * 10)).second);
+
+        REQUIRE(map.capacity() > capacity);
+        REQUIRE(map.size() == 9999);
+        for (uint64_t i = 1; i != 10000; ++i)
+            REQUIRE(map.find(i) == static_cast<uint32_t>(i * 10));
+    }
+}
+
+TEST_CASE("Concurrent sentinel set", "[concurrent_sentinel_map]")
+{
+    dze::concurrent_sentinel_set<int32_t, -1> set{1000};
+    const size_t capacity = set.capacity();
+
+    for (int32_t i = 0; i != 1000; ++i)
+        REQUIRE(set.insert(i));
+
+    REQUIRE(!set.insert(0));
+    REQUIRE(set.contains(999));
+    REQUIRE(!set.contains(1000));
+    REQUIRE(set.capacity() == capacity);
+}
+
+TEST_CASE("Concurrent sentinel map across threads", "[concurrent_sentinel_map]")
+{
+    constexpr size_t thread_count = 4;
+    constexpr uint64_t key_count = 20000;
+
+    // Starts small so that the threads resize it several times while inserting.
+    dze::concurrent_sentinel_map<uint64_t, uint64_t, ~uint64_t{0}, ~uint64_t{0}> map;
+    std::atomic<uint64_t> inserted{0};
+    std::atomic<bool> consistent{true};
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t != thread_count; ++t)
+    {
+        threads.emplace_back([&, t] {
+            // Every thread inserts every key, starting at a different one.
+            for (uint64_t i = 0; i != key_count; ++i)
+            {
+                const uint64_t key = (i + t * key_count / thread_count) % key_count;
+                const auto [value, was_inserted] = map.insert(key, key * thread_count + t);
+                inserted.fetch_add(was_inserted, std::memory_order_relaxed);
+
+                // Whichever thread won, the value is that of this key and stays visible.
+                if (value / thread_count != key || map.find(key) != value)
+                    consistent.store(false, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(consistent.load());
+    REQUIRE(inserted.load() == key_count);
+    REQUIRE(map.size() == key_count);
+    for (uint64_t key = 0; key != key_count; ++key)
+        REQUIRE(map.find(key).has_value());
+}
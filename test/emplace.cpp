@@ -1,8 +1,14 @@
 #include "optional.hpp"
 #include "optional_reference.hpp"
 
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include <catch2/catch.hpp>
 
@@ -41,3 +47,218 @@ TEST_CASE("Emplace reference", "[emplace.ref]")
         CHECK(*o1 == 84);
     }
 }
+
+namespace {
+
+struct immovable
+{
+    int value;
+
+    explicit immovable(const int i)
+        : value{i} {}
+
+    immovable(const immovable&) = delete;
+    immovable& operator=(const immovable&) = delete;
+};
+
+struct throwing
+{
+    explicit throwing(const bool do_throw)
+    {
+        if (do_throw)
+            throw std::runtime_error{"throwing"};
+    }
+
+    // NOLINTNEXTLINE(modernize-use-equals-default)
+    ~throwing() {}
+};
+
+} // namespace
+
+TEST_CASE("Emplace with", "[emplace.with]")
+{
+    dze::optional<immovable> o;
+    CHECK(o.emplace_with([] { return immovable{1}; }).value == 1);
+    CHECK(o.emplace_with([] { return immovable{2}; }).value == 2);
+
+    dze::test::ff_sentinel<int> s;
+    CHECK(s.emplace_with([] { return 42; }) == 42);
+    CHECK(s == 42);
+
+    dze::optional<long> l;
+    CHECK(l.emplace_with([] { return 42; }) == 42);
+}
+
+TEST_CASE("Emplace exception safety", "[emplace.except]")
+{
+    dze::optional<throwing> o{std::in_place, false};
+    REQUIRE_THROWS_AS(o.emplace(true), std::runtime_error);
+    CHECK(!o);
+    REQUIRE_THROWS_AS(o.emplace_with([] { return throwing{true}; }), std::runtime_error);
+    CHECK(!o);
+}
+
+TEST_CASE("Assign or emplace", "[emplace.assign]")
+{
+    dze::optional<std::vector<int>> o;
+    o.assign_or_emplace(100, 1);
+    REQUIRE(o);
+    CHECK(*o == std::vector<int>(100, 1));
+    const auto* const data = o->data();
+
+    const std::vector<int> source(50, 3);
+    o.assign_or_emplace(source);
+    CHECK(*o == source);
+    CHECK(o->data() == data);
+
+    o.assign_or_emplace(10, 2);
+    CHECK(*o == std::vector<int>(10, 2));
+
+    dze::optional<const std::string> c;
+    c.assign_or_emplace(3, 'a');
+    c.assign_or_emplace("b");
+    CHECK(*c == "b");
+
+    dze::test::ff_sentinel<int> s;
+    CHECK(s.assign_or_emplace(1) == 1);
+    CHECK(s.assign_or_emplace(2) == 2);
+}
+
+TEST_CASE("Take", "[emplace.take]")
+{
+    dze::optional<std::string> o{std::string(100, 'a')};
+    const auto* const data = o->data();
+
+    auto taken = o.take();
+    CHECK(!o);
+    REQUIRE(taken);
+    CHECK(taken->data() == data);
+    CHECK(!o.take());
+
+    dze::test::ff_sentinel<int> s = 1;
+    CHECK(s.take() == 1);
+    CHECK(!s);
+}
+
+TEST_CASE("Exchange", "[emplace.exchange]")
+{
+    dze::optional<std::string> o;
+    CHECK(!o.exchange("a"));
+    CHECK(o == "a");
+
+    const auto old = o.exchange(std::string(50, 'b'));
+    CHECK(old == "a");
+    CHECK(*o == std::string(50, 'b'));
+
+    // The new value may refer to the old one.
+    CHECK(o.exchange(*o + "c") == std::string(50, 'b'));
+    CHECK(*o == std::string(50, 'b') + "c");
+
+    dze::test::ff_sentinel<int> s;
+    CHECK(!s.exchange(1));
+    CHECK(s.exchange(2) == 1);
+    CHECK(s == 2);
+}
+
+TEST_CASE("Emplace raw", "[emplace.raw]")
+{
+    struct record
+    {
+        int a;
+        double b;
+    };
+
+    const record source{1, 2.0};
+
+    SECTION("default policy")
+    {
+        dze::optional<record> o;
+        CHECK(o.emplace_raw([&](std::byte* const storage) {
+            std::memcpy(storage, &source, sizeof(source));
+        }));
+        REQUIRE(o);
+        CHECK(o->a == 1);
+        CHECK(o->b == 2.0);
+
+        CHECK(!o.emplace_raw([](std::byte*) { return false; }));
+        CHECK(!o);
+
+        // Byte counts as returned by read() succeed only for a whole record.
+        const auto read = [&](const std::ptrdiff_t result) {
+            return [&, result](std::byte* const storage) {
+                std::memcpy(storage, &source, sizeof(source));
+                return result;
+            };
+        };
+        CHECK(!o.emplace_raw(read(0)));
+        CHECK(!o);
+        CHECK(!o.emplace_raw(read(-1)));
+        CHECK(!o);
+        CHECK(!o.emplace_raw(read(sizeof(record) / 2)));
+        CHECK(!o);
+        CHECK(o.emplace_raw(read(sizeof(record))));
+        CHECK(o->a == 1);
+        CHECK(!o.emplace_raw([&](std::byte*) { return size_t{0}; }));
+        CHECK(!o);
+    }
+
+    SECTION("sentinel policy")
+    {
+        const int null = -1;
+        const int value = 42;
+
+        dze::sentinel<int, -1> o;
+        CHECK(o.emplace_raw([&](std::byte* const storage) {
+            std::memcpy(storage, &value, sizeof(value));
+            return true;
+        }));
+        CHECK(o == 42);
+
+        // The null representation is rejected.
+        CHECK(!o.emplace_raw([&](std::byte* const storage) {
+            std::memcpy(storage, &null, sizeof(null));
+        }));
+        CHECK(!o);
+
+        o = 1;
+        CHECK(!o.emplace_raw([&](std::byte* const storage) {
+            std::memcpy(storage, &value, 2);
+            return false;
+        }));
+        CHECK(!o);
+
+        CHECK(!o.emplace_raw([&](std::byte* const storage) {
+            std::memcpy(storage, &value, 2);
+            return std::ptrdiff_t{2};
+        }));
+        CHECK(!o);
+
+        o = 1;
+        CHECK_THROWS_AS(
+            o.emplace_raw([&](std::byte* const storage) {
+                std::memcpy(storage, &value, 2);
+                throw std::runtime_error{"fill"};
+            }),
+            std::runtime_error);
+        CHECK(!o);
+    }
+
+    SECTION("bulk")
+    {
+        const std::array<int, 4> values = {1, -1, 3, 4};
+        std::array<dze::sentinel<int, -1>, 4> opts;
+
+        const size_t bytes = dze::emplace_raw(
+            opts.data(),
+            opts.data() + opts.size(),
+            [&](std::byte* const storage, const size_t size) {
+                std::memcpy(storage, values.data(), size);
+                return size;
+            });
+        CHECK(bytes == sizeof(values));
+        CHECK(opts[0] == 1);
+        CHECK(!opts[1]);
+        CHECK(opts[2] == 3);
+        CHECK(opts[3] == 4);
+    }
+}
@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <string_view>
+
+#include <dze/frozen_map.hpp>
+
+#include <catch2/catch.hpp>
+
+using namespace std::string_view_literals;
+
+namespace {
+
+enum class error_code : uint16_t
+{
+    ok,
+    not_found = 404,
+    teapot = 418,
+    internal = 500,
+    none = 0xFFFF
+};
+
+constexpr auto error_names =
+    dze::make_frozen_map<error_code, std::string_view, error_code::none>({
+        {error_code::ok, "ok"},
+        {error_code::not_found, "not found"},
+        {error_code::teapot, "I'm a teapot"},
+        {error_code::internal, "internal error"}});
+
+int twice(const int x) { return x * 2; }
+
+int square(const int x) { return x * x; }
+
+} // namespace
+
+TEST_CASE("Frozen map at compile time", "[frozen_map]")
+{
+    STATIC_REQUIRE(error_names.size() == 4);
+    STATIC_REQUIRE(error_names.find(error_code::teapot) == "I'm a teapot"sv);
+    STATIC_REQUIRE(error_names.find(static_cast<error_code>(200)) == dze::nullopt);
+    STATIC_REQUIRE(!error_names.contains(static_cast<error_code>(403)));
+    STATIC_REQUIRE(error_names.contains(error_code::ok));
+
+    REQUIRE(error_names.get(error_code::internal) == "internal error"sv);
+    REQUIRE(error_names.get(static_cast<error_code>(1)) == dze::nullopt);
+}
+
+TEST_CASE("Frozen map of handlers", "[frozen_map]")
+{
+    using handler = int (*)(int);
+
+    static constexpr auto handlers = dze::make_frozen_map<uint8_t, handler, 0xFF>({
+        {1, &twice},
+        {2, &square}});
+
+    REQUIRE((*handlers.find(1))(5) == 10);
+    REQUIRE((*handlers.find(2))(5) == 25);
+    REQUIRE(!handlers.find(3));
+}
+
+TEST_CASE("Frozen map with colliding keys", "[frozen_map]")
+{
+    struct constant
+    {
+        constexpr size_t operator()(int32_t) const noexcept { return 0; }
+    };
+
+    constexpr auto map = dze::make_frozen_map<int32_t, int32_t, -1, constant>({
+        {0, 0},
+        {1, 10},
+        {2, 20},
+        {3, 30},
+        {4, 40}});
+
+    STATIC_REQUIRE(map.max_probe() == 4);
+    for (int32_t key = 0; key != 5; ++key)
+        REQUIRE(map.find(key) == key * 10);
+
+    REQUIRE(!map.contains(5));
+}
@@ -0,0 +1,149 @@
+#include "optional.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <dze/gather.hpp>
+
+#include <catch2/catch.hpp>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+// This test is also built with AVX2 and with AVX-512, which the machine running it may lack.
+bool simd_supported()
+{
+#if defined(__AVX512F__)
+    return __builtin_cpu_supports("avx512f");
+#elif defined(__AVX2__)
+    return __builtin_cpu_supports("avx2");
+#else
+    return true;
+#endif
+}
+
+using index_type = dze::sentinel<uint32_t, UINT32_MAX>;
+
+std::vector<index_type> make_indices(const size_t size, const uint32_t table_size)
+{
+    std::mt19937 engine{static_cast<uint32_t>(size)};
+    std::bernoulli_distribution engaged{0.6};
+    std::uniform_int_distribution<uint32_t> index{0, table_size - 1};
+
+    std::vector<index_type> result(size);
+    for (auto& idx : result)
+    {
+        if (engaged(engine))
+            idx = index(engine);
+    }
+
+    return result;
+}
+
+template <typename T>
+T make_value(const size_t i)
+{
+    if constexpr (std::is_same_v<T, std::string>)
+        return std::to_string(i);
+    else
+        return static_cast<T>(i * 3 + 1);
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE(
+    "Gather optional",
+    "[gather]",
+    dze::optional<int32_t>,
+    (dze::sentinel<int32_t, -1>),
+    (dze::sentinel<uint64_t, UINT64_MAX>),
+    dze::test::ff_sentinel<double>,
+    dze::optional<std::string>)
+{
+    if (!simd_supported())
+        return;
+
+    using value_type = typename TestType::value_type;
+
+    constexpr uint32_t table_size = 1000;
+
+    std::vector<value_type> table;
+    for (size_t i = 0; i != table_size; ++i)
+        table.push_back(make_value<value_type>(i));
+
+    for (const size_t size : {0, 1, 7, 8, 16, 17, 1000})
+    {
+        const auto indices = make_indices(size, table_size);
+
+        // Engaged outputs must be overwritten by nulls too.
+        std::vector<TestType> out(size, make_value<value_type>(0));
+        dze::gather_optional(indices.data(), indices.data() + size, table.data(), out.data());
+
+        for (size_t i = 0; i != size; ++i)
+        {
+            if (indices[i])
+            {
+                REQUIRE(out[i].has_value());
+                REQUIRE(*out[i] == table[*indices[i]]);
+            }
+            else
+                REQUIRE_FALSE(out[i].has_value());
+        }
+    }
+}
+
+#if defined(__linux__)
+
+TEST_CASE("Gather optional with indices that have the top bit set", "[gather]")
+{
+    if (!simd_supported())
+        return;
+
+    // Gather instructions take signed offsets, so vectors with such indices take the scalar
+    // path, while the other vectors are still gathered. The table is reserved address space,
+    // of which only the used entries are touched.
+    constexpr uint32_t high = 0x80000001;
+    constexpr size_t table_size = size_t{high} + 1;
+
+    void* const memory = mmap(
+        nullptr,
+        table_size * sizeof(int32_t),
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+        -1,
+        0);
+    REQUIRE(memory != MAP_FAILED);
+    const auto table = static_cast<int32_t*>(memory);
+
+    std::vector<index_type> indices(48);
+    for (uint32_t i = 0; i != indices.size(); ++i)
+    {
+        if (i % 5 != 0)
+            indices[i] = i;
+
+        table[i] = static_cast<int32_t>(i * 3 + 1);
+    }
+    indices[3] = high;
+    indices[20] = high;
+    table[high] = 42;
+
+    std::vector<dze::sentinel<int32_t, -1>> out(indices.size(), 0);
+    dze::gather_optional(indices.data(), indices.data() + indices.size(), table, out.data());
+
+    for (size_t i = 0; i != indices.size(); ++i)
+    {
+        if (indices[i])
+            REQUIRE(out[i] == table[*indices[i]]);
+        else
+            REQUIRE_FALSE(out[i].has_value());
+    }
+
+    munmap(memory, table_size * sizeof(int32_t));
+}
+
+#endif
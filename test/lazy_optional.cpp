@@ -0,0 +1,82 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <dze/lazy_optional.hpp>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Lazy optional", "[lazy_optional]")
+{
+    int calls = 0;
+    dze::lazy_optional o{[&] {
+        ++calls;
+        return std::string(32, 'a');
+    }};
+
+    STATIC_REQUIRE(std::is_same_v<decltype(o)::value_type, std::string>);
+
+    REQUIRE(!o.has_value());
+    REQUIRE(o.get_if() == nullptr);
+    REQUIRE(calls == 0);
+
+    REQUIRE(o.value() == std::string(32, 'a'));
+    REQUIRE(o->size() == 32);
+    REQUIRE(calls == 1);
+    REQUIRE(o.has_value());
+    REQUIRE(o.get_if() == &*o);
+
+    SECTION("Invalidate")
+    {
+        o.invalidate();
+        REQUIRE(!o.has_value());
+        REQUIRE(calls == 1);
+        REQUIRE(o.value().size() == 32);
+        REQUIRE(calls == 2);
+    }
+}
+
+TEST_CASE("Lazy optional with a throwing initializer", "[lazy_optional]")
+{
+    int calls = 0;
+    dze::lazy_optional o{[&] {
+        if (++calls == 1)
+            throw std::runtime_error{"first"};
+
+        return 42;
+    }};
+
+    REQUIRE_THROWS_AS(o.value(), std::runtime_error);
+    REQUIRE(!o.has_value());
+    REQUIRE(*o == 42);
+    REQUIRE(calls == 2);
+}
+
+TEST_CASE("Lazy optional initializes once under contention", "[lazy_optional]")
+{
+    std::atomic<int> calls{0};
+    dze::lazy_optional o{[&] {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        std::this_thread::yield();
+        return std::vector<int>(1000, 7);
+    }};
+
+    std::atomic<bool> mismatch{false};
+    std::vector<std::thread> threads;
+    for (int i = 0; i != 8; ++i)
+    {
+        threads.emplace_back([&] {
+            if (o.value() != std::vector<int>(1000, 7))
+                mismatch = true;
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    REQUIRE(calls == 1);
+    REQUIRE(!mismatch);
+}
@@ -0,0 +1,111 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <dze/memo_cache.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+// Long enough to be allocated, so that leaked or doubly destroyed values show up.
+std::string spell(const int32_t i) { return std::string(32, static_cast<char>('a' + i % 26)); }
+
+// Maps every key to the same set.
+struct constant_hash
+{
+    size_t operator()(const dze::sentinel<int32_t, -1>&) const noexcept { return 0; }
+};
+
+} // namespace
+
+TEST_CASE("Memo cache", "[memo_cache]")
+{
+    dze::memo_cache<int32_t, std::string, -1> cache{100};
+    REQUIRE(cache.capacity() == 128);
+    REQUIRE(cache.find(1) == nullptr);
+    REQUIRE(cache.misses() == 1);
+
+    int calls = 0;
+    const auto compute = [&](const int32_t key) {
+        ++calls;
+        return spell(key);
+    };
+
+    REQUIRE(cache.get_or_compute(1, compute) == spell(1));
+    REQUIRE(cache.get_or_compute(1, compute) == spell(1));
+    REQUIRE(calls == 1);
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.misses() == 2);
+
+    cache.emplace(1, spell(2));
+    REQUIRE(*cache.find(1) == spell(2));
+
+    SECTION("A throwing computation caches nothing")
+    {
+        REQUIRE_THROWS_AS(
+            cache.get_or_compute(
+                3, [](int32_t) -> std::string { throw std::runtime_error{"failed"}; }),
+            std::runtime_error);
+        REQUIRE(cache.find(3) == nullptr);
+    }
+
+    SECTION("Clear")
+    {
+        cache.clear();
+        REQUIRE(cache.find(1) == nullptr);
+        cache.reset_counters();
+        REQUIRE(cache.hits() == 0);
+        REQUIRE(cache.misses() == 0);
+    }
+}
+
+TEST_CASE("Memo cache collisions", "[memo_cache]")
+{
+    SECTION("Direct-mapped")
+    {
+        dze::memo_cache<int32_t, std::string, -1, 1, constant_hash> cache{16};
+        cache.emplace(1, spell(1));
+        cache.emplace(2, spell(2));
+        REQUIRE(cache.find(1) == nullptr);
+        REQUIRE(*cache.find(2) == spell(2));
+    }
+
+    SECTION("Set-associative")
+    {
+        dze::memo_cache<int32_t, std::string, -1, 4, constant_hash> cache{16};
+        for (int32_t i = 0; i != 4; ++i)
+            cache.emplace(i, spell(i));
+
+        for (int32_t i = 0; i != 4; ++i)
+            REQUIRE(*cache.find(i) == spell(i));
+
+        // The set is full, so one of the four is overwritten.
+        cache.emplace(4, spell(4));
+        REQUIRE(*cache.find(4) == spell(4));
+        int32_t kept = 0;
+        for (int32_t i = 0; i != 4; ++i)
+            kept += cache.find(i) != nullptr;
+
+        REQUIRE(kept == 3);
+    }
+}
+
+TEST_CASE("Memo cache counters from another thread", "[memo_cache]")
+{
+    dze::memo_cache<int32_t, int32_t, -1, 2> cache{64};
+    std::thread worker{[&] {
+        for (int32_t i = 0; i != 1000; ++i)
+            static_cast<void>(cache.get_or_compute(i % 10, [](const int32_t key) { return key; }));
+    }};
+
+    // Reading while the worker runs is allowed.
+    uint64_t observed = 0;
+    while (observed < 1000)
+        observed = cache.hits() + cache.misses();
+
+    worker.join();
+    REQUIRE(cache.misses() == 10);
+    REQUIRE(cache.hits() == 990);
+}
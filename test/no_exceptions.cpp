@@ -0,0 +1,131 @@
+// Built with exceptions disabled, so it does not use Catch2. Calls value() on every wrapper
+// and checks that a disengaged one calls the bad access handler, which jumps back here
+// instead of letting the failure abort. Also instantiates the sorts, which catch exceptions
+// of their worker threads only when exceptions are enabled.
+
+#include <csetjmp>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dze/allocator_optional.hpp>
+#include <dze/boxed_optional.hpp>
+#include <dze/lazy_optional.hpp>
+#include <dze/optional.hpp>
+#include <dze/optional_index.hpp>
+#include <dze/optional_reference.hpp>
+#include <dze/recycling_optional.hpp>
+#include <dze/sentinel.hpp>
+#include <dze/shared_optional.hpp>
+#include <dze/sort.hpp>
+#include <dze/tagged_optional_reference.hpp>
+
+static_assert(!DZE_OPTIONAL_HAS_EXCEPTIONS);
+static_assert(!DZE_OPTIONAL_THROW_BAD_ACCESS);
+
+namespace {
+
+int failures = 0;
+
+std::jmp_buf bad_access_jump;
+
+[[noreturn]] void jump_back() { std::longjmp(bad_access_jump, 1); }
+
+void check(const bool condition, const char* const what)
+{
+    if (!condition)
+    {
+        std::fprintf(stderr, "FAILED: %s\n", what);
+        ++failures;
+    }
+}
+
+#define CHECK(...) check((__VA_ARGS__), #__VA_ARGS__)
+
+// Whether opt.value() reached the bad access handler. The frames between here and the handler
+// have nothing to destroy, so jumping over them is fine.
+template <typename Opt, typename... Base>
+bool bad_access(const Opt& opt, Base&... base)
+{
+    if (setjmp(bad_access_jump) == 0)
+    {
+        static_cast<void>(opt.value(base...));
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main()
+{
+    dze::set_bad_optional_access_handler(&jump_back);
+
+    {
+        dze::optional<std::string> engaged = "a";
+        CHECK(engaged.value() == "a");
+        CHECK(bad_access(dze::optional<std::string>{}));
+        CHECK(bad_access(dze::sentinel<int, -1>{}));
+    }
+
+    {
+        const dze::boxed_optional<std::string> engaged = "b";
+        CHECK(engaged.value() == "b");
+        CHECK(bad_access(dze::boxed_optional<std::string>{}));
+    }
+
+    {
+        dze::recycling_optional<std::vector<int>> o{std::in_place, 3, 1};
+        CHECK(o.value().size() == 3);
+        o.recycle_reset();
+        CHECK(bad_access(o));
+    }
+
+    {
+        const dze::shared_optional<std::string> engaged = "c";
+        CHECK(engaged.value() == "c");
+        CHECK(bad_access(dze::shared_optional<std::string>{}));
+    }
+
+    {
+        using opt = dze::allocator_optional<std::string, std::allocator<char>>;
+        const opt engaged{std::string{"d"}};
+        CHECK(engaged.value() == "d");
+        CHECK(bad_access(opt{}));
+    }
+
+    {
+        const dze::lazy_optional lazy{[] { return 4; }};
+        CHECK(lazy.value() == 4);
+    }
+
+    {
+        int i = 5;
+        CHECK(dze::optional_reference<int>{i}.value() == 5);
+        CHECK(bad_access(dze::optional_reference<int>{}));
+
+        CHECK(dze::tagged_optional_reference<int, 2>{i, 1}.value() == 5);
+        CHECK(bad_access(dze::tagged_optional_reference<int, 2>{dze::nullopt, 1}));
+
+        const std::vector<int> base{6};
+        CHECK(dze::optional_index<int>{0}.value(base) == 6);
+        CHECK(bad_access(dze::optional_index<int>{}, base));
+    }
+
+    {
+        std::vector<dze::optional<std::string>> strings = {"b", {}, "a"};
+        dze::parallel_sort_optionals(strings.begin(), strings.end(), dze::null_order::last, 2);
+        CHECK(strings[0] == "a" && strings[1] == "b" && !strings[2]);
+
+        std::vector<dze::sentinel<int, -1>> ints = {3, {}, 1, 2};
+        dze::parallel_sort_optionals(ints.begin(), ints.end(), dze::null_order::first, 2);
+        CHECK(!ints[0] && ints[1] == 1 && ints[2] == 2 && ints[3] == 3);
+    }
+
+    if (failures == 0)
+        std::puts("All tests passed");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -1,4 +1,5 @@
 #include "optional.hpp"
+#include "optional_reference.hpp"
 
 #include <type_traits>
 #include <utility>
@@ -29,6 +30,21 @@ TEMPLATE_TEST_CASE("Observers", "[observers]", dze::optional<int>, (dze::sentine
         REQUIRE(*o3 == 42);
         REQUIRE(o3.value() == 42);
     }
+
+    SECTION("Unchecked value")
+    {
+        TestType o1 = 42;
+        const TestType o2 = 42;
+
+        STATIC_REQUIRE(std::is_same_v<decltype(o1.value_unchecked()), int&>);
+        STATIC_REQUIRE(std::is_same_v<decltype(o2.value_unchecked()), const int&>);
+        STATIC_REQUIRE(std::is_same_v<decltype(std::move(o1).value_unchecked()), int&&>);
+        STATIC_REQUIRE(noexcept(o1.value_unchecked()));
+
+        o1.value_unchecked() = 43;
+        REQUIRE(*o1 == 43);
+        REQUIRE(o2.value_unchecked() == 42);
+    }
 }
 
 TEMPLATE_TEST_CASE(
@@ -70,3 +86,48 @@ TEST_CASE("Observers", "[observers]")
         REQUIRE(!o5.been_moved);
     }
 }
+
+TEST_CASE("Unchecked value of optional references", "[observers]")
+{
+    int i = 42;
+    const dze::optional_reference o = i;
+
+    STATIC_REQUIRE(std::is_same_v<decltype(o.value_unchecked()), int&>);
+    REQUIRE(&o.value_unchecked() == &i);
+}
+
+TEST_CASE("Bad optional access handler", "[observers]")
+{
+    struct handler_exception {};
+
+    REQUIRE(dze::get_bad_optional_access_handler() == nullptr);
+
+    dze::optional<int> o1;
+    dze::sentinel<int, -1> o2;
+    int i = 42;
+    dze::optional_reference<int> o3;
+
+    REQUIRE_THROWS_AS(o1.value(), dze::bad_optional_access);
+
+    const auto previous =
+        dze::set_bad_optional_access_handler([] { throw handler_exception{}; });
+    REQUIRE(previous == nullptr);
+
+    REQUIRE_THROWS_AS(o1.value(), handler_exception);
+    REQUIRE_THROWS_AS(std::move(o1).value(), handler_exception);
+    REQUIRE_THROWS_AS(o2.value(), handler_exception);
+    REQUIRE_THROWS_AS(o3.value(), handler_exception);
+
+    o3 = i;
+    REQUIRE(o3.value() == 42);
+
+    // A handler that returns falls through to the default failure.
+    static int calls = 0;
+    dze::set_bad_optional_access_handler([] { ++calls; });
+    REQUIRE_THROWS_AS(o1.value(), dze::bad_optional_access);
+    REQUIRE(calls == 1);
+
+    dze::set_bad_optional_access_handler(nullptr);
+    REQUIRE_THROWS_AS(o2.value(), dze::bad_optional_access);
+    REQUIRE(calls == 1);
+}
@@ -0,0 +1,151 @@
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include <dze/optional_index.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+struct node
+{
+    int value;
+    dze::optional_index<node> next;
+};
+
+} // namespace
+
+static_assert(sizeof(dze::optional_index<node>) == sizeof(uint32_t));
+static_assert(sizeof(node) == 2 * sizeof(uint32_t));
+static_assert(dze::is_trivially_relocatable_v<dze::optional_index<node>>);
+
+// The index of an element is its distance from the first, which takes contiguous elements.
+static_assert(std::is_constructible_v<
+    dze::optional_index<int>, const std::vector<int>&, const int&>);
+static_assert(std::is_constructible_v<
+    dze::optional_index<int, std::array<int, 3>>, const std::array<int, 3>&, const int&>);
+static_assert(std::is_constructible_v<
+    dze::optional_index<int, int*>, int* const&, const int&>);
+static_assert(!std::is_constructible_v<
+    dze::optional_index<int, std::deque<int>>, const std::deque<int>&, const int&>);
+static_assert(!std::is_constructible_v<
+    dze::optional_index<int, std::vector<long>>, const std::vector<long>&, const int&>);
+
+TEST_CASE("Optional index", "[optional_index]")
+{
+    std::vector<node> nodes{{1, {}}, {2, {}}, {3, {}}};
+
+    dze::optional_index<node> index;
+    REQUIRE(!index);
+    REQUIRE(index == dze::nullopt);
+    REQUIRE(index.raw_index() == dze::optional_index<node>::null_index);
+    REQUIRE(index.resolve(nodes) == dze::nullopt);
+    REQUIRE(index.value_or(nodes, node{4, {}}).value == 4);
+    CHECK_THROWS_AS(index.value(nodes), dze::bad_optional_access);
+
+    index.emplace(nodes, nodes[2]);
+    REQUIRE(index.has_value());
+    REQUIRE(index.index() == 2);
+    REQUIRE(&index.value(nodes) == &nodes[2]);
+    REQUIRE(index.value_or(nodes, node{4, {}}).value == 3);
+
+    // Stays valid when the container reallocates.
+    nodes.resize(1000);
+    REQUIRE(index.resolve(nodes)->value == 3);
+
+    index.value_unchecked(nodes).value = 5;
+    REQUIRE(nodes[2].value == 5);
+
+    const auto& const_nodes = nodes;
+    const dze::optional_reference<const node> ref = index.resolve(const_nodes);
+    REQUIRE(&*ref == &nodes[2]);
+
+    index.emplace(0);
+    REQUIRE(index.value(nodes).value == 1);
+
+    index = dze::nullopt;
+    REQUIRE(!index.has_value());
+
+    index = dze::optional_index<node>{1};
+    index.reset();
+    REQUIRE(index == dze::nullopt);
+}
+
+TEST_CASE("Optional index into other containers", "[optional_index]")
+{
+    // A deque is not contiguous, so its indices are made from numbers only.
+    std::deque<int> deque{1, 2, 3};
+    const dze::optional_index<int, std::deque<int>> in_deque{1};
+    REQUIRE(in_deque.resolve(deque) == 2);
+
+    const std::array<int, 3> array{7, 8, 9};
+    dze::optional_index<int, std::array<int, 3>> in_array;
+    in_array.emplace(array, array[1]);
+    REQUIRE(in_array.index() == 1);
+    REQUIRE(in_array.value(array) == 8);
+
+    int arena[] = {4, 5, 6};
+    int* const base = arena;
+    const dze::optional_index<int, int*> in_arena{base, arena[2]};
+    REQUIRE(in_arena.index() == 2);
+    REQUIRE(in_arena.value(base) == 6);
+}
+
+TEST_CASE("Optional index linked list", "[optional_index]")
+{
+    std::vector<node> nodes(10);
+    for (uint32_t i = 0; i != 10; ++i)
+    {
+        nodes[i].value = static_cast<int>(i);
+        if (i != 9)
+            nodes[i].next.emplace(i + 1);
+    }
+
+    int sum = 0;
+    for (auto it = dze::optional_index<node>{0}; it; it = it.value_unchecked(nodes).next)
+        sum += it.value_unchecked(nodes).value;
+
+    REQUIRE(sum == 45);
+}
+
+TEST_CASE("Optional index relops", "[optional_index]")
+{
+    using index = dze::optional_index<int>;
+
+    constexpr index null;
+    constexpr index zero{0};
+    constexpr index one{1};
+
+    STATIC_REQUIRE(null == null);
+    STATIC_REQUIRE(null != zero);
+    STATIC_REQUIRE(null < zero);
+    STATIC_REQUIRE(zero < one);
+    STATIC_REQUIRE(one > null);
+    STATIC_REQUIRE(zero <= zero);
+    STATIC_REQUIRE(one >= zero);
+    STATIC_REQUIRE(!(one < zero));
+
+    STATIC_REQUIRE(null == dze::nullopt);
+    STATIC_REQUIRE(dze::nullopt != zero);
+    STATIC_REQUIRE(dze::nullopt < zero);
+    STATIC_REQUIRE(!(zero < dze::nullopt));
+    STATIC_REQUIRE(zero > dze::nullopt);
+    STATIC_REQUIRE(dze::nullopt <= null);
+    STATIC_REQUIRE(zero >= dze::nullopt);
+    STATIC_REQUIRE(!(dze::nullopt >= zero));
+}
+
+TEST_CASE("Optional index hash", "[optional_index]")
+{
+    using index = dze::optional_index<int>;
+
+    REQUIRE(dze::hash<index>{}(index{7}) == std::hash<uint32_t>{}(7));
+    REQUIRE(dze::hash<index>{}(index{}) == dze::hash<dze::optional<uint32_t>>{}(dze::nullopt));
+
+    std::unordered_set<index, dze::hash<index>> set{index{}, index{1}, index{1}, index{2}};
+    REQUIRE(set.size() == 3);
+}
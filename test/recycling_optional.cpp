@@ -0,0 +1,150 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dze/recycling_optional.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+struct counter
+{
+    counter() = default;
+
+    counter(const int v, const int r) noexcept
+        : value{v}
+        , recycled{r} {}
+
+    int value = 0;
+    int recycled = 0;
+};
+
+} // namespace
+
+template <>
+struct dze::recycle_traits<counter>
+{
+    static void recycle(counter& c) noexcept
+    {
+        c.value = 0;
+        ++c.recycled;
+    }
+};
+
+TEST_CASE("Recycling reset", "[recycling_optional.recycle]")
+{
+    dze::recycling_optional<std::vector<int>> o;
+    CHECK(!o);
+
+    o.emplace(100, 1);
+    REQUIRE(o);
+    const auto* const data = o->data();
+
+    SECTION("emplace")
+    {
+        o.recycle_reset();
+        CHECK(!o);
+        CHECK(o == dze::nullopt);
+        CHECK_THROWS_AS(o.value(), dze::bad_optional_access);
+
+        CHECK(o.emplace().empty());
+        CHECK(o->capacity() >= 100);
+        CHECK(o->data() == data);
+
+        o.recycle_reset();
+        const std::vector<int> v(50, 2);
+        o.emplace(v);
+        CHECK(o == v);
+        CHECK(o->data() == data);
+
+        // Several arguments go through recycle_traits::assign.
+        o.recycle_reset();
+        o.emplace(80, 4);
+        CHECK(o == std::vector<int>(80, 4));
+        CHECK(o->data() == data);
+
+        o.emplace(size_t{3}, 5);
+        CHECK(o == std::vector<int>(3, 5));
+        CHECK(o->data() == data);
+
+        // Without arguments, an engaged value is recycled into a default constructed one.
+        CHECK(o.emplace().empty());
+        CHECK(o->data() == data);
+    }
+
+    SECTION("assignment")
+    {
+        o.recycle_reset();
+        const std::vector<int> v(50, 2);
+        o = v;
+        CHECK(*o == v);
+        CHECK(o->data() == data);
+
+        dze::recycling_optional<std::vector<int>> other = std::vector<int>(10, 3);
+        o.recycle_reset();
+        o = other;
+        CHECK(o == other);
+        CHECK(o->data() == data);
+        other.recycle_reset();
+        o = other;
+        CHECK(!o);
+    }
+
+    SECTION("reset")
+    {
+        o.reset();
+        CHECK(!o);
+        o.emplace();
+        CHECK(o->capacity() == 0);
+
+        o = std::vector<int>{1};
+        o = dze::nullopt;
+        CHECK(!o);
+        o.emplace();
+        CHECK(o->capacity() == 0);
+    }
+}
+
+TEST_CASE("Recycling emplace without arguments", "[recycling_optional.recycle]")
+{
+    dze::recycling_optional<std::string> s{"abc"};
+    CHECK(s.emplace().empty());
+    CHECK(s == std::string{});
+
+    dze::recycling_optional<std::vector<int>> v{std::in_place, 3, 1};
+    CHECK(v.emplace().empty());
+    CHECK(v == std::vector<int>{});
+}
+
+TEST_CASE("Recycling with custom traits", "[recycling_optional.traits]")
+{
+    dze::recycling_optional<counter> o{std::in_place, counter{1, 0}};
+    o.recycle_reset();
+    o.recycle_reset();
+    CHECK(o.emplace().recycled == 1);
+    CHECK(o->value == 0);
+    CHECK(o.emplace().recycled == 2);
+
+    // Without assign in the traits, several arguments assign a temporary.
+    o.recycle_reset();
+    CHECK(o.emplace(2, 0).value == 2);
+    CHECK(o->recycled == 0);
+}
+
+TEST_CASE("Recycling optional observers", "[recycling_optional.observers]")
+{
+    dze::recycling_optional<std::string> o1 = "a";
+    dze::recycling_optional<std::string> o2;
+    CHECK(o1.value() == "a");
+    CHECK(o2.value_or("b") == "b");
+    CHECK(o1 != o2);
+
+    swap(o1, o2);
+    CHECK(!o1);
+    CHECK(o2 == "a");
+
+    o1 = std::move(o2);
+    CHECK(o1 == "a");
+    CHECK(std::move(o1).value() == "a");
+}
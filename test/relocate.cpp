@@ -0,0 +1,159 @@
+#include "optional.hpp"
+
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include <dze/optional_reference.hpp>
+#include <dze/relocate.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+// Owns heap memory and has no pointers into itself.
+struct unique_int
+{
+    std::unique_ptr<int> ptr;
+
+    explicit unique_int(const int i)
+        : ptr{std::make_unique<int>(i)} {}
+};
+
+} // namespace
+
+template <>
+struct dze::is_trivially_relocatable<unique_int> : std::true_type {};
+
+TEST_CASE("Trivial relocatability", "[relocate.trait]")
+{
+    STATIC_REQUIRE(dze::is_trivially_relocatable_v<int>);
+    STATIC_REQUIRE(!dze::is_trivially_relocatable_v<std::string>);
+    STATIC_REQUIRE(dze::is_trivially_relocatable_v<unique_int>);
+
+    STATIC_REQUIRE(dze::is_trivially_relocatable_v<dze::optional<int>>);
+    STATIC_REQUIRE(dze::is_trivially_relocatable_v<dze::optional<const int>>);
+    STATIC_REQUIRE(dze::is_trivially_relocatable_v<dze::sentinel<int, -1>>);
+    STATIC_REQUIRE(dze::is_trivially_relocatable_v<dze::optional<unique_int>>);
+    STATIC_REQUIRE(dze::is_trivially_relocatable_v<dze::optional<dze::optional<unique_int>>>);
+    STATIC_REQUIRE(!dze::is_trivially_relocatable_v<dze::optional<std::string>>);
+
+    STATIC_REQUIRE(dze::is_trivially_relocatable_v<dze::optional_reference<std::string>>);
+}
+
+TEST_CASE("Relocation-based swap", "[relocate.swap]")
+{
+    STATIC_REQUIRE(noexcept(std::declval<dze::optional<unique_int>&>().swap(
+        std::declval<dze::optional<unique_int>&>())));
+
+    dze::optional<unique_int> o1{std::in_place, 1};
+    dze::optional<unique_int> o2;
+
+    SECTION("engaged with disengaged")
+    {
+        o1.swap(o2);
+        REQUIRE(!o1);
+        REQUIRE(o2);
+        CHECK(*o2->ptr == 1);
+
+        swap(o1, o2);
+        REQUIRE(o1);
+        REQUIRE(!o2);
+        CHECK(*o1->ptr == 1);
+    }
+
+    SECTION("engaged with engaged")
+    {
+        o2.emplace(2);
+        o1.swap(o2);
+        CHECK(*o1->ptr == 2);
+        CHECK(*o2->ptr == 1);
+    }
+
+    SECTION("self")
+    {
+        o1.swap(o1);
+        CHECK(*o1->ptr == 1);
+    }
+
+    SECTION("sentinel")
+    {
+        dze::sentinel<int, -1> s1 = 1;
+        dze::sentinel<int, -1> s2;
+        s1.swap(s2);
+        CHECK(!s1);
+        CHECK(s2 == 1);
+    }
+
+    SECTION("optional reference")
+    {
+        int i = 1;
+        dze::optional_reference<int> r1 = i;
+        dze::optional_reference<int> r2;
+        r1.swap(r2);
+        CHECK(!r1);
+        CHECK(&*r2 == &i);
+    }
+}
+
+TEST_CASE("Relocation", "[relocate.relocate]")
+{
+    SECTION("trivially relocatable")
+    {
+        using opt = dze::optional<unique_int>;
+        constexpr size_t size = 10;
+
+        std::allocator<opt> alloc;
+        opt* const source = alloc.allocate(size);
+        opt* const dest = alloc.allocate(size);
+        for (size_t i = 0; i != size; ++i)
+        {
+            if (i % 3 == 0)
+                ::new (static_cast<void*>(source + i)) opt{};
+            else
+                ::new (static_cast<void*>(source + i)) opt{std::in_place, static_cast<int>(i)};
+        }
+
+        REQUIRE(dze::uninitialized_relocate(source, source + size, dest) == dest + size);
+        for (size_t i = 0; i != size; ++i)
+        {
+            REQUIRE(dest[i].has_value() == (i % 3 != 0));
+            if (dest[i])
+                CHECK(*dest[i]->ptr == static_cast<int>(i));
+        }
+
+        // Overlapping ranges.
+        dze::uninitialized_relocate(dest + 1, dest + size, dest);
+        CHECK(*dest[0]->ptr == 1);
+        CHECK(!dest[2]);
+        CHECK(!dest[8]);
+        dze::relocate_at(dest + 7, dest + 9);
+        CHECK(*dest[9]->ptr == 8);
+
+        std::destroy(dest, dest + 7);
+        std::destroy(dest + 8, dest + size);
+        alloc.deallocate(dest, size);
+        alloc.deallocate(source, size);
+    }
+
+    SECTION("not trivially relocatable")
+    {
+        using opt = dze::optional<std::string>;
+
+        std::allocator<opt> alloc;
+        opt* const source = alloc.allocate(3);
+        opt* const dest = source + 2;
+        ::new (static_cast<void*>(source)) opt{std::string(100, 'a')};
+        ::new (static_cast<void*>(source + 1)) opt{};
+
+        dze::relocate_at(source + 0, dest);
+        CHECK(*dest == std::string(100, 'a'));
+        dze::relocate_at(source + 1, source);
+        CHECK(!*source);
+
+        std::destroy_at(source);
+        std::destroy_at(dest);
+        alloc.deallocate(source, 3);
+    }
+}
@@ -1,15 +1,23 @@
 #include "optional.hpp"
 
+#include <cstdint>
+#include <limits>
 #include <optional>
 #include <string>
 
 #include <catch2/catch.hpp>
 
-TEMPLATE_TEST_CASE("Relational ops", "[relops]", dze::optional<int>, (dze::sentinel<int, -1>))
+TEMPLATE_TEST_CASE(
+    "Relational ops",
+    "[relops]",
+    dze::optional<int>,
+    (dze::sentinel<int, -1>),
+    (dze::sentinel<int, std::numeric_limits<int>::min()>))
 {
     TestType o1{4};
     TestType o2{42};
     TestType o3;
+    TestType o4;
 
     SECTION("self")
     {
@@ -31,6 +39,29 @@ TEMPLATE_TEST_CASE("Relational ops", "[relops]", dze::optional<int>, (dze::senti
         REQUIRE_FALSE(o1 >= o2);
     }
 
+    SECTION("disengaged")
+    {
+        REQUIRE_FALSE(o1 == o3);
+        REQUIRE_FALSE(o3 == o1);
+        REQUIRE(o1 != o3);
+        REQUIRE(o3 != o1);
+        REQUIRE_FALSE(o1 < o3);
+        REQUIRE(o3 < o1);
+        REQUIRE(o1 > o3);
+        REQUIRE_FALSE(o3 > o1);
+        REQUIRE_FALSE(o1 <= o3);
+        REQUIRE(o3 <= o1);
+        REQUIRE(o1 >= o3);
+        REQUIRE_FALSE(o3 >= o1);
+
+        REQUIRE(o3 == o4);
+        REQUIRE_FALSE(o3 != o4);
+        REQUIRE_FALSE(o3 < o4);
+        REQUIRE_FALSE(o3 > o4);
+        REQUIRE(o3 <= o4);
+        REQUIRE(o3 >= o4);
+    }
+
     SECTION("nullopt")
     {
         REQUIRE_FALSE(o1 == std::nullopt);
@@ -178,3 +209,50 @@ TEMPLATE_TEST_CASE(
         REQUIRE("hello" >= o1);
     }
 }
+
+TEST_CASE("Null sorts first", "[relops.null_sorts_first]")
+{
+    using namespace dze::details::optional_ns;
+
+    STATIC_REQUIRE(null_sorts_first_v<sentinel_value_policy<int64_t, INT64_MIN>>);
+    STATIC_REQUIRE(null_sorts_first_v<sentinel_value_policy<uint32_t, 0>>);
+    STATIC_REQUIRE(!null_sorts_first_v<sentinel_value_policy<int64_t, -1>>);
+    STATIC_REQUIRE(!null_sorts_first_v<sentinel_value_policy<uint32_t, UINT32_MAX>>);
+    STATIC_REQUIRE(!null_sorts_first_v<default_policy>);
+    STATIC_REQUIRE(!null_sorts_first_v<dze::test::ff_policy<sizeof(int)>>);
+
+    using opt = dze::sentinel<int64_t, INT64_MIN>;
+
+    const opt null;
+    const opt min{INT64_MIN + 1};
+    const opt max{INT64_MAX};
+
+    REQUIRE(null < min);
+    REQUIRE(min < max);
+    REQUIRE(null == opt{});
+    REQUIRE(max >= min);
+    REQUIRE_FALSE(null > max);
+}
+
+#ifdef __cpp_lib_three_way_comparison
+TEMPLATE_TEST_CASE(
+    "Three-way comparison",
+    "[relops.three_way]",
+    dze::optional<int>,
+    (dze::sentinel<int, -1>),
+    (dze::sentinel<int, std::numeric_limits<int>::min()>))
+{
+    TestType o1{4};
+    TestType o2{42};
+    TestType o3;
+
+    REQUIRE(std::is_eq(o1 <=> o1));
+    REQUIRE(std::is_lt(o1 <=> o2));
+    REQUIRE(std::is_gt(o2 <=> o1));
+    REQUIRE(std::is_lt(o3 <=> o1));
+    REQUIRE(std::is_gt(o1 <=> o3));
+    REQUIRE(std::is_eq(o3 <=> TestType{}));
+    REQUIRE(std::is_gt(o1 <=> std::nullopt));
+    REQUIRE(std::is_eq(o3 <=> std::nullopt));
+}
+#endif
@@ -0,0 +1,108 @@
+#include "optional.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <dze/select.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+constexpr dze::compare_op ops[] = {
+    dze::compare_op::equal_to,
+    dze::compare_op::not_equal_to,
+    dze::compare_op::less,
+    dze::compare_op::less_equal,
+    dze::compare_op::greater,
+    dze::compare_op::greater_equal};
+
+template <typename T, typename U>
+bool matches(const T& opt, const dze::compare_op op, const U& value)
+{
+    if (!opt)
+        return false;
+
+    switch (op)
+    {
+        case dze::compare_op::equal_to:
+            return *opt == value;
+        case dze::compare_op::not_equal_to:
+            return *opt != value;
+        case dze::compare_op::less:
+            return *opt < value;
+        case dze::compare_op::less_equal:
+            return *opt <= value;
+        case dze::compare_op::greater:
+            return *opt > value;
+        case dze::compare_op::greater_equal:
+            return *opt >= value;
+    }
+
+    return false;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE(
+    "Select",
+    "[select]",
+    dze::optional<int32_t>,
+    (dze::sentinel<int32_t, -1>),
+    (dze::sentinel<int32_t, std::numeric_limits<int32_t>::min()>),
+    dze::test::ff_sentinel<double>)
+{
+    std::mt19937 engine{42};
+    std::bernoulli_distribution engaged{0.7};
+    std::uniform_int_distribution<int32_t> values{0, 100};
+
+    for (const size_t size : {0, 1, 63, 64, 65, 1000})
+    {
+        std::vector<TestType> input(size);
+        for (auto& opt : input)
+        {
+            if (engaged(engine))
+                opt = values(engine);
+        }
+
+        for (const auto op : ops)
+        {
+            std::vector<uint32_t> expected;
+            for (size_t i = 0; i != size; ++i)
+            {
+                if (matches(input[i], op, 42))
+                    expected.push_back(static_cast<uint32_t>(i));
+            }
+
+            std::vector<uint32_t> selection(size);
+            const auto count =
+                dze::select(input.data(), input.data() + size, op, 42, selection.data());
+            selection.resize(count);
+            REQUIRE(selection == expected);
+
+            std::vector<uint64_t> mask((size + 63) / 64);
+            dze::select_mask(input.data(), input.data() + size, op, 42, mask.data());
+            for (size_t i = 0; i != size; ++i)
+                REQUIRE(((mask[i / 64] >> (i % 64)) & 1) == matches(input[i], op, 42));
+        }
+    }
+}
+
+TEST_CASE("Select non-arithmetic", "[select]")
+{
+    const std::vector<dze::optional<std::string>> input = {"a", {}, "c", "b", {}};
+
+    std::vector<uint32_t> selection(input.size());
+    const auto count = dze::select(
+        input.data(),
+        input.data() + input.size(),
+        dze::compare_op::greater,
+        std::string{"a"},
+        selection.data());
+    selection.resize(count);
+    REQUIRE(selection == std::vector<uint32_t>{2, 3});
+}
@@ -0,0 +1,170 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <dze/sentinel_map.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+using key_type = dze::sentinel<int32_t, -1>;
+
+// Puts every key into one of a few long clusters, which exercises probing across groups and
+// shifting back on erasure.
+struct clustering_hash
+{
+    size_t operator()(const key_type& key) const noexcept
+    {
+        return static_cast<size_t>(*key % 3);
+    }
+};
+
+enum class color : uint8_t
+{
+    red,
+    green,
+    blue,
+    none = 0xFF
+};
+
+template <typename Map>
+void check_against_unordered_map(const int32_t key_count)
+{
+    Map map;
+    std::unordered_map<int32_t, int32_t> expected;
+
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<int32_t> keys{0, key_count - 1};
+    for (int32_t i = 0; i != 20000; ++i)
+    {
+        const int32_t key = keys(gen);
+        if (gen() % 3 == 0)
+            REQUIRE(map.erase(key) == (expected.erase(key) != 0));
+        else
+            REQUIRE(map.try_emplace(key, i).second == expected.try_emplace(key, i).second);
+
+        REQUIRE(map.size() == expected.size());
+    }
+
+    for (int32_t key = 0; key != key_count; ++key)
+    {
+        const auto it = expected.find(key);
+        if (it == expected.end())
+            REQUIRE(map.find(key) == nullptr);
+        else
+            REQUIRE(*map.find(key) == it->second);
+    }
+}
+
+} // namespace
+
+namespace std {
+
+template <>
+struct hash<color>
+{
+    size_t operator()(const color c) const noexcept { return static_cast<size_t>(c); }
+};
+
+} // namespace std
+
+TEST_CASE("Sentinel map", "[sentinel_map]")
+{
+    dze::sentinel_map<int32_t, std::string, -1> map;
+    REQUIRE(map.empty());
+    REQUIRE(map.capacity() == 0);
+    REQUIRE(map.find(1) == nullptr);
+    REQUIRE(!map.erase(1));
+
+    const auto [value, inserted] = map.try_emplace(1, "one");
+    REQUIRE(inserted);
+    REQUIRE(value == "one");
+    REQUIRE(!map.try_emplace(1, "uno").second);
+    REQUIRE(*map.find(1) == "one");
+
+    map[2] = "two";
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.contains(2));
+    REQUIRE(!map.contains(3));
+
+    SECTION("Erase")
+    {
+        REQUIRE(map.erase(1));
+        REQUIRE(!map.erase(1));
+        REQUIRE(map.find(1) == nullptr);
+        REQUIRE(*map.find(2) == "two");
+        REQUIRE(map.size() == 1);
+    }
+
+    SECTION("Growth")
+    {
+        for (int32_t i = 0; i != 1000; ++i)
+            map[i] = std::to_string(i);
+
+        REQUIRE(map.size() == 1000);
+        REQUIRE(map.capacity() % dze::sentinel_map<int32_t, std::string, -1>::group_size == 0);
+        for (int32_t i = 0; i != 1000; ++i)
+            REQUIRE(*map.find(i) == std::to_string(i));
+    }
+
+    SECTION("Copy and move")
+    {
+        auto copy = map;
+        REQUIRE(copy.size() == 2);
+        REQUIRE(*copy.find(1) == "one");
+
+        auto moved = std::move(copy);
+        REQUIRE(copy.empty());
+        REQUIRE(copy.find(1) == nullptr);
+        REQUIRE(*moved.find(2) == "two");
+
+        copy = moved;
+        copy[3] = "three";
+        REQUIRE(!moved.contains(3));
+    }
+
+    SECTION("Clear keeps the capacity")
+    {
+        const size_t capacity = map.capacity();
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE(map.capacity() == capacity);
+        REQUIRE(!map.contains(1));
+    }
+
+    SECTION("For each")
+    {
+        std::unordered_map<int32_t, std::string> entries;
+        map.for_each([&](const int32_t key, std::string& v) { entries.emplace(key, v); });
+        REQUIRE(entries == std::unordered_map<int32_t, std::string>{{1, "one"}, {2, "two"}});
+    }
+}
+
+TEST_CASE("Sentinel map matches std::unordered_map", "[sentinel_map]")
+{
+    // Twelve keys nearly fill the smallest table, whose clusters then wrap around its end.
+    check_against_unordered_map<dze::sentinel_map<int32_t, int32_t, -1>>(12);
+    check_against_unordered_map<dze::sentinel_map<int32_t, int32_t, -1, clustering_hash>>(200);
+}
+
+TEST_CASE("Sentinel set", "[sentinel_map]")
+{
+    dze::sentinel_set<color, color::none> set;
+    REQUIRE(set.insert(color::red));
+    REQUIRE(set.insert(color::blue));
+    REQUIRE(!set.insert(color::red));
+    REQUIRE(set.contains(color::blue));
+    REQUIRE(!set.contains(color::green));
+
+    std::vector<color> colors;
+    set.for_each([&](const color c) { colors.push_back(c); });
+    REQUIRE(colors.size() == 2);
+
+    REQUIRE(set.erase(color::red));
+    REQUIRE(!set.contains(color::red));
+    REQUIRE(set.size() == 1);
+}
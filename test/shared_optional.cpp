@@ -0,0 +1,135 @@
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <dze/shared_optional.hpp>
+
+#include <catch2/catch.hpp>
+
+TEMPLATE_TEST_CASE(
+    "Shared optional",
+    "[shared_optional.basic]",
+    dze::shared_optional<std::string>,
+    dze::local_shared_optional<std::string>)
+{
+    STATIC_REQUIRE(sizeof(TestType) == sizeof(void*));
+
+    TestType o1;
+    CHECK(!o1);
+    CHECK(o1.use_count() == 0);
+    CHECK_THROWS_AS(std::as_const(o1).value(), dze::bad_optional_access);
+
+    o1.emplace(100, 'a');
+    REQUIRE(o1);
+    CHECK(o1.unique());
+
+    auto o2 = o1;
+    CHECK(o1.use_count() == 2);
+    CHECK(o1.shares_with(o2));
+    CHECK(&*std::as_const(o1) == &*std::as_const(o2));
+    CHECK(o1 == o2);
+
+    SECTION("copy on write")
+    {
+        const auto* const shared = &*std::as_const(o1);
+        o2->push_back('b');
+        CHECK(!o1.shares_with(o2));
+        CHECK(o1.unique());
+        CHECK(o2.unique());
+        CHECK(&*std::as_const(o1) == shared);
+        CHECK(*o2 == std::string(100, 'a') + 'b');
+        CHECK(o1 != o2);
+
+        // A unique value is modified in place.
+        o1.value() += 'c';
+        CHECK(&*std::as_const(o1) == shared);
+    }
+
+    SECTION("assignment")
+    {
+        o2 = "b";
+        CHECK(o1 == std::string(100, 'a'));
+        CHECK(o2 == "b");
+
+        const auto* const unique = &*std::as_const(o2);
+        o2 = "c";
+        CHECK(&*std::as_const(o2) == unique);
+
+        o1 = o2;
+        CHECK(o1.shares_with(o2));
+        o1 = o1;
+        CHECK(o1.use_count() == 2);
+
+        o2 = dze::nullopt;
+        CHECK(o1.unique());
+        CHECK(o2 == dze::nullopt);
+        CHECK(o2.value_or("d") == "d");
+
+        o2 = std::move(o1);
+        CHECK(!o1);
+        CHECK(o2 == "c");
+
+        swap(o1, o2);
+        CHECK(o1 == "c");
+        CHECK(!o2);
+    }
+
+    SECTION("hash")
+    {
+        CHECK(dze::hash<TestType>{}(o1) == std::hash<std::string>{}(std::string(100, 'a')));
+        CHECK(
+            dze::hash<TestType>{}(TestType{}) ==
+            dze::hash<dze::optional<std::string>>{}(dze::nullopt));
+    }
+}
+
+TEST_CASE("Shared optional across threads", "[shared_optional.threads]")
+{
+    const dze::shared_optional<std::vector<int>> source{std::in_place, 1000, 1};
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i != 4; ++i)
+    {
+        threads.emplace_back([&source] {
+            for (int j = 0; j != 1000; ++j)
+            {
+                auto copy = source;
+                CHECK(copy->size() == 1000);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    CHECK(source.unique());
+}
+
+TEST_CASE("Shared optional references outlive unsharing", "[shared_optional.aliasing]")
+{
+    // The reference was handed out before the copy, so the copy gets its own value.
+    dze::shared_optional<std::string> a = "a";
+    std::string& r = *a;
+    const auto b = a;
+    CHECK(!a.shares_with(b));
+    r = "x";
+    CHECK(*b == "a");
+    CHECK(*a == "x");
+
+    dze::shared_optional<std::string> c;
+    c = a;
+    CHECK(!c.shares_with(a));
+    r = "y";
+    CHECK(*c == "x");
+
+    // Self-assignment keeps the value and the reference.
+    a = std::as_const(a);
+    r = "z";
+    CHECK(*a == "z");
+
+    // A replaced value is shareable again.
+    a.emplace("w");
+    const auto d = a;
+    CHECK(d.shares_with(a));
+    CHECK(a.use_count() == 2);
+}
@@ -0,0 +1,279 @@
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <dze/slot_map.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+size_t allocations = 0;
+
+} // namespace
+
+// Counts allocations, so that tests can check that an operation does not allocate.
+void* operator new(const size_t size)
+{
+    ++allocations;
+    if (void* const p = std::malloc(size == 0 ? 1 : size))
+        return p;
+
+    throw std::bad_alloc{};
+}
+
+void* operator new[](const size_t size) { return operator new(size); }
+
+void* operator new(const size_t size, const std::nothrow_t&) noexcept
+{
+    ++allocations;
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](const size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* const p) noexcept { std::free(p); }
+
+void operator delete(void* const p, size_t) noexcept { std::free(p); }
+
+void operator delete[](void* const p) noexcept { std::free(p); }
+
+void operator delete[](void* const p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Counts its moves, and is trivially relocatable so that relocating it does not move it.
+struct move_counter
+{
+    static inline int moves = 0;
+
+    int value;
+
+    explicit move_counter(const int v) noexcept
+        : value{v} {}
+
+    move_counter(move_counter&& other) noexcept
+        : value{other.value}
+    {
+        ++moves;
+    }
+
+    move_counter& operator=(move_counter&&) = delete;
+};
+
+} // namespace
+
+template <>
+struct dze::is_trivially_relocatable<move_counter> : std::true_type {};
+
+namespace {
+
+// Long enough strings to be allocated.
+template <typename T>
+T make(const int i)
+{
+    if constexpr (std::is_same_v<T, std::string>)
+        return std::string(32, static_cast<char>('a' + i));
+    else
+        return static_cast<T>(i);
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Slot map", "[slot_map]", std::string, int64_t, uint8_t)
+{
+    dze::slot_map<TestType> map;
+    REQUIRE(map.empty());
+
+    const auto h1 = map.insert(make<TestType>(1));
+    const auto h2 = map.insert(make<TestType>(2));
+    const auto h3 = map.emplace(make<TestType>(3));
+    REQUIRE(map.size() == 3);
+    REQUIRE(*map.get(h1) == make<TestType>(1));
+    REQUIRE(*map.get(h2) == make<TestType>(2));
+    REQUIRE(*map.get(h3) == make<TestType>(3));
+
+    SECTION("Erase invalidates handles")
+    {
+        REQUIRE(map.erase(h2));
+        REQUIRE(!map.erase(h2));
+        REQUIRE(!map.contains(h2));
+        REQUIRE(map.get(h2) == nullptr);
+        REQUIRE(map.size() == 2);
+
+        // The slot is reused with a new generation.
+        const auto h4 = map.insert(make<TestType>(4));
+        REQUIRE(h4.index == h2.index);
+        REQUIRE(h4 != h2);
+        REQUIRE(map.get(h2) == nullptr);
+        REQUIRE(*map.get(h4) == make<TestType>(4));
+        REQUIRE(map.slot_count() == 3);
+    }
+
+    SECTION("Free slots are reused last in, first out")
+    {
+        map.erase(h1);
+        map.erase(h3);
+        REQUIRE(map.insert(make<TestType>(5)).index == h3.index);
+        REQUIRE(map.insert(make<TestType>(6)).index == h1.index);
+        REQUIRE(map.insert(make<TestType>(7)).index == 3);
+    }
+
+    SECTION("Iteration")
+    {
+        map.erase(h2);
+
+        std::vector<TestType> values;
+        for (const auto& value : map)
+            values.push_back(value);
+        REQUIRE(values == std::vector<TestType>{make<TestType>(1), make<TestType>(3)});
+
+        std::vector<typename dze::slot_map<TestType>::handle> handles;
+        map.for_each([&](const auto h, auto& value) {
+            REQUIRE(map.get(h) == &value);
+            handles.push_back(h);
+        });
+        REQUIRE(handles.size() == 2);
+        REQUIRE(handles[0] == h1);
+        REQUIRE(handles[1] == h3);
+    }
+
+    SECTION("Copy rebuilds the free list")
+    {
+        map.erase(h1);
+        map.erase(h3);
+
+        const auto copy = map;
+        auto other = copy;
+        REQUIRE(other.size() == 1);
+        REQUIRE(*other.get(h2) == make<TestType>(2));
+        REQUIRE(other.insert(make<TestType>(8)).index == h1.index);
+        REQUIRE(other.insert(make<TestType>(9)).index == h3.index);
+    }
+
+    SECTION("Clear")
+    {
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE(!map.contains(h1));
+        REQUIRE(map.insert(make<TestType>(10)).index == 0);
+        REQUIRE(map.slot_count() == 3);
+    }
+}
+
+TEST_CASE("Slot map with a throwing constructor", "[slot_map]")
+{
+    struct thrower
+    {
+        int value;
+
+        explicit thrower(const int v)
+            : value{v}
+        {
+            if (v < 0)
+                throw std::runtime_error{"negative"};
+        }
+    };
+
+    dze::slot_map<thrower> map;
+    const auto h1 = map.emplace(1);
+    const auto h2 = map.emplace(2);
+    map.erase(h1);
+    map.erase(h2);
+
+    REQUIRE_THROWS_AS(map.emplace(-1), std::runtime_error);
+    REQUIRE(map.emplace(3).index == h2.index);
+    REQUIRE(map.emplace(4).index == h1.index);
+    REQUIRE(map.slot_count() == 2);
+}
+
+TEST_CASE("Slot map stops allocating at its peak size", "[slot_map]")
+{
+    dze::slot_map<int64_t> map;
+    std::vector<dze::slot_map<int64_t>::handle> handles;
+    for (int64_t i = 0; i != 1000; ++i)
+        handles.push_back(map.insert(i));
+
+    for (int round = 0; round != 10; ++round)
+    {
+        for (size_t i = round % 2; i < handles.size(); i += 2)
+        {
+            REQUIRE(map.erase(handles[i]));
+            handles[i] = map.insert(static_cast<int64_t>(i));
+        }
+    }
+
+    REQUIRE(map.slot_count() == 1000);
+    REQUIRE(map.size() == 1000);
+    for (size_t i = 0; i != handles.size(); ++i)
+        REQUIRE(*map.get(handles[i]) == static_cast<int64_t>(i));
+}
+
+TEMPLATE_TEST_CASE(
+    "Slot map keeps its free slots when reserving", "[slot_map]", std::string, int64_t)
+{
+    dze::slot_map<TestType> map;
+    const auto a = map.insert(make<TestType>(1));
+    const auto b = map.insert(make<TestType>(2));
+    const auto c = map.insert(make<TestType>(3));
+    map.erase(a);
+    map.erase(c);
+
+    // Reallocates the slots, which used to lose the links of the free list.
+    map.reserve(1000);
+
+    const auto d = map.insert(make<TestType>(4));
+    const auto e = map.insert(make<TestType>(5));
+    CHECK(map.slot_count() == 3);
+    CHECK(*map.get(b) == make<TestType>(2));
+    CHECK(*map.get(d) == make<TestType>(4));
+    CHECK(*map.get(e) == make<TestType>(5));
+    CHECK(!map.contains(a));
+    CHECK(!map.contains(c));
+
+    map.insert(make<TestType>(6));
+    CHECK(map.slot_count() == 4);
+}
+
+TEMPLATE_TEST_CASE(
+    "Slot map erases without allocating", "[slot_map]", std::string, int64_t, uint8_t)
+{
+    dze::slot_map<TestType> map;
+    std::vector<typename dze::slot_map<TestType>::handle> handles;
+    for (int i = 0; i != 1000; ++i)
+        handles.push_back(map.insert(make<TestType>(i % 20)));
+
+    // erase is noexcept, so it must not grow the list of free slots.
+    const size_t before = allocations;
+    for (const auto h : handles)
+        REQUIRE(map.erase(h));
+    CHECK(allocations == before);
+
+    const auto copy = map;
+    auto other = copy;
+    other.insert(make<TestType>(1));
+    CHECK(map.empty());
+    CHECK(other.size() == 1);
+}
+
+TEST_CASE("Slot map relocates its slots when growing", "[slot_map]")
+{
+    STATIC_REQUIRE(dze::is_trivially_relocatable_v<dze::optional<move_counter>>);
+
+    dze::slot_map<move_counter> map;
+    std::vector<dze::slot_map<move_counter>::handle> handles;
+    for (int i = 0; i != 1000; ++i)
+        handles.push_back(map.emplace(i));
+    map.reserve(5000);
+
+    CHECK(move_counter::moves == 0);
+    for (int i = 0; i != 1000; ++i)
+        REQUIRE(map.get(handles[static_cast<size_t>(i)])->value == i);
+}
@@ -0,0 +1,160 @@
+#include "optional.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <dze/sort.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+template <typename T>
+std::vector<T> make_input(const size_t size)
+{
+    using value_type = typename T::value_type;
+
+    std::mt19937_64 engine{size};
+    std::bernoulli_distribution engaged{0.8};
+    std::vector<T> result(size);
+    for (auto& opt : result)
+    {
+        if (!engaged(engine))
+            continue;
+
+        if constexpr (std::is_floating_point_v<value_type>)
+            opt = std::uniform_real_distribution<value_type>{-1e6, 1e6}(engine);
+        else if constexpr (std::is_integral_v<value_type>)
+        {
+            // Stay clear of the sentinel values used below.
+            opt = std::uniform_int_distribution<value_type>{
+                static_cast<value_type>(std::numeric_limits<value_type>::min() + 1),
+                static_cast<value_type>(std::numeric_limits<value_type>::max() - 1)}(engine);
+        }
+        else
+            opt = std::to_string(engine());
+    }
+
+    return result;
+}
+
+template <typename T>
+std::vector<T> expected(std::vector<T> input, const dze::null_order order)
+{
+    std::stable_sort(input.begin(), input.end());
+    if (order == dze::null_order::last)
+    {
+        std::rotate(
+            input.begin(),
+            std::find_if(input.begin(), input.end(), [](const T& opt) { return !!opt; }),
+            input.end());
+    }
+
+    return input;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE(
+    "Sort optionals",
+    "[sort]",
+    dze::optional<int>,
+    (dze::sentinel<int, -1>),
+    (dze::sentinel<int64_t, std::numeric_limits<int64_t>::min()>),
+    (dze::sentinel<uint8_t, 0xFF>),
+    (dze::sentinel<uint32_t, std::numeric_limits<uint32_t>::max()>),
+    dze::optional<double>,
+    dze::test::ff_sentinel<float>,
+    dze::optional<std::string>)
+{
+    for (const auto order : {dze::null_order::first, dze::null_order::last})
+    {
+        for (const size_t size : {0, 1, 2, 100, 5000})
+        {
+            auto input = make_input<TestType>(size);
+            const auto result = expected(input, order);
+
+            dze::sort_optionals(input.begin(), input.end(), order);
+            REQUIRE(input == result);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Parallel sort optionals",
+    "[sort.parallel]",
+    (dze::sentinel<int64_t, std::numeric_limits<int64_t>::min()>),
+    dze::optional<double>,
+    dze::optional<std::string>)
+{
+    for (const auto order : {dze::null_order::first, dze::null_order::last})
+    {
+        auto input = make_input<TestType>(100'000);
+        const auto result = expected(input, order);
+
+        dze::parallel_sort_optionals(input.begin(), input.end(), order, 5);
+        REQUIRE(input == result);
+    }
+}
+
+TEST_CASE("Parallel sort optionals with NaNs and signed zeros", "[sort.parallel]")
+{
+    // NaNs are unordered under operator<, so merging the sorted chunks must use the order of
+    // the radix sort.
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<dze::optional<double>> input(size_t{1} << 17);
+    for (size_t i = 0; i != input.size(); ++i)
+    {
+        if (i % 97 == 0)
+            input[i] = nan;
+        else if (i % 101 == 0)
+            input[i] = i % 2 == 0 ? 0.0 : -0.0;
+        else if (i % 103 != 0)
+            input[i] = static_cast<double>(i);
+    }
+
+    for (const auto order : {dze::null_order::first, dze::null_order::last})
+    {
+        auto serial = input;
+        dze::sort_optionals(serial.begin(), serial.end(), order);
+        auto parallel = input;
+        dze::parallel_sort_optionals(parallel.begin(), parallel.end(), order, 4);
+
+        const auto engaged_first = std::find_if(
+            parallel.begin(), parallel.end(), [](const auto& opt) { return !!opt; });
+        const auto engaged_last = std::find_if(
+            engaged_first, parallel.end(), [](const auto& opt) { return !opt; });
+        REQUIRE(std::all_of(
+            engaged_last, parallel.end(), [](const auto& opt) { return !opt; }));
+
+        // -0.0, +0.0, the ascending values and then all NaNs.
+        const auto first_nan = std::find_if(
+            engaged_first, engaged_last, [](const auto& opt) { return std::isnan(*opt); });
+        CHECK(engaged_last - first_nan == static_cast<std::ptrdiff_t>(input.size() / 97 + 1));
+        CHECK(std::all_of(
+            first_nan, engaged_last, [](const auto& opt) { return std::isnan(*opt); }));
+        CHECK(std::is_sorted(engaged_first, first_nan));
+        const auto first_positive = std::find_if(
+            engaged_first, first_nan, [](const auto& opt) { return !std::signbit(*opt); });
+        CHECK(std::all_of(
+            engaged_first, first_positive, [](const auto& opt) { return *opt == 0.0; }));
+        CHECK(first_positive != engaged_first);
+        CHECK(*first_positive == 0.0);
+
+        for (size_t i = 0; i != input.size(); ++i)
+        {
+            REQUIRE(serial[i].has_value() == parallel[i].has_value());
+            if (serial[i])
+            {
+                REQUIRE(std::signbit(*serial[i]) == std::signbit(*parallel[i]));
+                REQUIRE((*serial[i] == *parallel[i] ||
+                    (std::isnan(*serial[i]) && std::isnan(*parallel[i]))));
+            }
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#include "optional.hpp"
+
+#include <cstdint>
+#include <thread>
+
+#include <dze/sentinel.hpp>
+#include <dze/spsc_ring.hpp>
+
+#include <catch2/catch.hpp>
+
+TEMPLATE_TEST_CASE(
+    "SPSC ring",
+    "[spsc_ring]",
+    (dze::spsc_ring<int32_t, dze::sentinel<int32_t, -1>::policy_type>),
+    (dze::padded_spsc_ring<int32_t, dze::sentinel<int32_t, -1>::policy_type>),
+    (dze::spsc_ring<int64_t, dze::test::ff_policy<8>>))
+{
+    TestType ring{3};
+    REQUIRE(ring.capacity() == 4);
+    REQUIRE(!ring.try_pop());
+
+    SECTION("Fill and drain")
+    {
+        for (int i = 0; i != 4; ++i)
+            REQUIRE(ring.try_push(i));
+        REQUIRE(!ring.try_push(4));
+
+        for (int i = 0; i != 4; ++i)
+            REQUIRE(ring.try_pop() == i);
+        REQUIRE(!ring.try_pop());
+    }
+
+    SECTION("Wrap around")
+    {
+        for (int i = 0; i != 10; ++i)
+        {
+            REQUIRE(ring.try_push(2 * i));
+            REQUIRE(ring.try_push(2 * i + 1));
+            REQUIRE(ring.try_pop() == 2 * i);
+            REQUIRE(ring.try_pop() == 2 * i + 1);
+        }
+
+        REQUIRE(!ring.try_pop());
+    }
+}
+
+TEST_CASE("SPSC ring across threads", "[spsc_ring]")
+{
+    constexpr int64_t count = 100'000;
+
+    dze::spsc_ring<int64_t, dze::test::ff_policy<8>> ring{64};
+    std::thread producer{[&] {
+        for (int64_t i = 0; i != count;)
+        {
+            if (ring.try_push(i))
+                ++i;
+        }
+    }};
+
+    bool in_order = true;
+    for (int64_t expected = 0; expected != count;)
+    {
+        if (const auto value = ring.try_pop())
+        {
+            in_order = in_order && *value == expected;
+            ++expected;
+        }
+    }
+
+    producer.join();
+    REQUIRE(in_order);
+}
@@ -0,0 +1,147 @@
+#include <cstdint>
+#include <cstring>
+
+#include <dze/tagged_optional_reference.hpp>
+
+#include <catch2/catch.hpp>
+
+// Whether tags can use the high bits of pointers.
+#if defined(__x86_64__) || defined(_M_X64) || \
+    ((defined(__aarch64__) || defined(_M_ARM64)) && DZE_OPTIONAL_AARCH64_HIGH_TAG_BITS)
+#define HIGH_TAG_BITS 1
+#else
+#define HIGH_TAG_BITS 0
+#endif
+
+#if HIGH_TAG_BITS
+
+namespace {
+
+// A node of a graph whose edges carry a kind, referring to the still incomplete node type.
+// The tag takes the three alignment bits and two high bits.
+struct node
+{
+    int value;
+    dze::tagged_optional_reference<node, 5> edge;
+};
+
+} // namespace
+
+static_assert(sizeof(node) == 2 * sizeof(void*));
+
+#endif
+
+static_assert(sizeof(dze::tagged_optional_reference<int, 2>) == sizeof(int*));
+static_assert(dze::is_trivially_relocatable_v<dze::tagged_optional_reference<int, 2>>);
+
+TEST_CASE("Tagged optional reference in alignment bits", "[tagged_optional_reference]")
+{
+    int x = 1;
+    int y = 2;
+
+    dze::tagged_optional_reference<int, 2> ref;
+    REQUIRE(!ref);
+    REQUIRE(ref == dze::nullopt);
+    REQUIRE(ref.tag() == 0);
+
+    ref.set_tag(3);
+    REQUIRE(!ref.has_value());
+    REQUIRE(ref.tag() == 3);
+    REQUIRE(ref.value_or(5) == 5);
+    CHECK_THROWS_AS(ref.value(), dze::bad_optional_access);
+
+    // Rebinding keeps the tag.
+    ref = x;
+    REQUIRE(ref.has_value());
+    REQUIRE(&*ref == &x);
+    REQUIRE(ref.tag() == 3);
+
+    ref.emplace(y);
+    REQUIRE(&ref.value() == &y);
+    REQUIRE(ref.tag() == 3);
+
+    *ref = 4;
+    REQUIRE(y == 4);
+
+    ref.set_tag(1);
+    REQUIRE(&*ref == &y);
+    REQUIRE(ref.tag() == 1);
+    REQUIRE(ref.reference() == 4);
+
+    ref.reset();
+    REQUIRE(ref == dze::nullopt);
+    REQUIRE(ref.tag() == 1);
+    REQUIRE(ref.reference() == dze::nullopt);
+}
+
+#if HIGH_TAG_BITS
+
+TEST_CASE("Tagged optional reference in high bits", "[tagged_optional_reference]")
+{
+    // char leaves no alignment bits, so the whole tag is above the address.
+    char c = 'a';
+    const char d = 'b';
+
+    dze::tagged_optional_reference<const char, 5> ref{c, 0x1F};
+    REQUIRE(*ref == 'a');
+    REQUIRE(ref.tag() == 0x1F);
+
+    dze::tagged_optional_reference<const char, 5> other{dze::nullopt, 2};
+    swap(ref, other);
+    REQUIRE(ref == dze::nullopt);
+    REQUIRE(ref.tag() == 2);
+    REQUIRE(*other == 'a');
+    REQUIRE(other.tag() == 0x1F);
+
+    ref = d;
+    REQUIRE(ref.value_unchecked() == 'b');
+    REQUIRE(ref.tag() == 2);
+
+    const dze::tagged_optional_reference<const char, 5> copy{dze::optional_reference{c}, 7};
+    REQUIRE(&*copy == &c);
+    REQUIRE(copy.tag() == 7);
+}
+
+TEST_CASE("Tagged optional reference across alignment and high bits",
+    "[tagged_optional_reference]")
+{
+    node a{1, {}};
+    node b{2, {a, 21}};
+    a.edge = b;
+    a.edge.set_tag(6);
+
+    REQUIRE(b.edge->value == 1);
+    REQUIRE(b.edge.tag() == 21);
+    REQUIRE(a.edge->edge->value == 1);
+    REQUIRE(a.edge.tag() == 6);
+
+    for (uint64_t tag = 0; tag <= decltype(a.edge)::max_tag; ++tag)
+    {
+        a.edge.set_tag(tag);
+        REQUIRE(a.edge.tag() == tag);
+        REQUIRE(&*a.edge == &b);
+    }
+}
+
+TEST_CASE("Tagged optional reference keeps the tag in the spare bits",
+    "[tagged_optional_reference]")
+{
+    using namespace dze::details::tagged_reference_ns;
+
+    // The top byte of a pointer on AArch64 may hold a tag of the system, which the tag must
+    // not overwrite.
+    constexpr uintptr_t spare =
+        ((uintptr_t{1} << spare_high_bits) - 1) << (spare_high_end - spare_high_bits);
+    static_assert(spare_high_end <= pointer_bits);
+
+    char c = 'a';
+    const dze::tagged_optional_reference<char, 5> ref{c, 0x1F};
+    uintptr_t bits;
+    std::memcpy(&bits, &ref, sizeof(bits));
+
+    const auto address = reinterpret_cast<uintptr_t>(&c);
+    REQUIRE((bits & ~spare) == address);
+    REQUIRE((bits & spare) != 0);
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include "optional.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <dze/versioned_optional.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+// Not a multiple of the word size.
+struct snapshot
+{
+    std::array<int64_t, 12> prices;
+    int32_t sequence;
+};
+
+snapshot make_snapshot(const int32_t sequence)
+{
+    snapshot result;
+    result.prices.fill(sequence);
+    result.sequence = sequence;
+    return result;
+}
+
+bool consistent(const snapshot& s)
+{
+    for (const int64_t price : s.prices)
+    {
+        if (price != s.sequence)
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE(
+    "Versioned optional",
+    "[versioned_optional]",
+    dze::optional<snapshot>,
+    dze::test::ff_sentinel<snapshot>)
+{
+    dze::versioned_optional<snapshot, typename TestType::policy_type> o;
+
+    REQUIRE(!o.has_value());
+    REQUIRE(o.version() == 0);
+
+    o.store(make_snapshot(1));
+    REQUIRE(o.version() == 2);
+
+    auto value = o.load();
+    REQUIRE(value);
+    REQUIRE(value->sequence == 1);
+    REQUIRE(consistent(*value));
+
+    o.emplace(make_snapshot(2));
+    TestType copy;
+    REQUIRE(o.try_load(copy));
+    REQUIRE(copy->sequence == 2);
+    REQUIRE(consistent(*copy));
+
+    o.reset();
+    REQUIRE(!o.has_value());
+    REQUIRE(o.version() == 6);
+
+}
+
+TEST_CASE("Versioned optional of a small value", "[versioned_optional]")
+{
+    const dze::versioned_optional<int> o{42};
+    REQUIRE(o.load() == 42);
+}
+
+TEST_CASE("Versioned optional readers see whole writes", "[versioned_optional]")
+{
+    constexpr int32_t writes = 20'000;
+
+    dze::versioned_optional<snapshot> o;
+    std::atomic<bool> torn{false};
+
+    const auto read = [&] {
+        int32_t last = 0;
+        while (last != writes)
+        {
+            if (const auto value = o.load())
+            {
+                if (!consistent(*value) || value->sequence < last)
+                    torn = true;
+
+                last = value->sequence;
+            }
+        }
+    };
+
+    std::vector<std::thread> readers;
+    readers.emplace_back(read);
+    readers.emplace_back(read);
+    for (int32_t i = 1; i <= writes; ++i)
+        o.store(make_snapshot(i));
+
+    for (auto& reader : readers)
+        reader.join();
+
+    REQUIRE(!torn);
+}
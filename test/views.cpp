@@ -0,0 +1,171 @@
+#include "optional.hpp"
+
+#include <forward_list>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dze/optional_reference.hpp>
+#include <dze/views.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+template <typename T>
+std::vector<T> make_input(const size_t size)
+{
+    std::vector<T> result(size);
+    for (size_t i = 0; i != size; ++i)
+    {
+        if (i % 3 != 0 || i % 64 == 5)
+            result[i] = static_cast<int>(i);
+    }
+
+    return result;
+}
+
+} // namespace
+
+TEMPLATE_TEST_CASE(
+    "Engaged view", "[views.engaged]", dze::optional<int>, (dze::sentinel<int, -1>))
+{
+    for (const size_t size : {0, 1, 3, 64, 65, 200})
+    {
+        auto input = make_input<TestType>(size);
+
+        std::vector<int> expected;
+        std::vector<std::pair<size_t, int>> expected_enumerated;
+        for (size_t i = 0; i != size; ++i)
+        {
+            if (input[i])
+            {
+                expected.push_back(*input[i]);
+                expected_enumerated.emplace_back(i, *input[i]);
+            }
+        }
+
+        std::vector<int> values;
+        for (const int i : input | dze::views::engaged)
+            values.push_back(i);
+        REQUIRE(values == expected);
+
+        std::vector<std::pair<size_t, int>> enumerated;
+        for (const auto [i, value] : dze::views::enumerate_engaged(input))
+            enumerated.emplace_back(i, value);
+        REQUIRE(enumerated == expected_enumerated);
+
+        for (int& i : input | dze::views::engaged)
+            i = -i - 2;
+        for (size_t i = 0; i != size; ++i)
+            REQUIRE((!input[i] || *input[i] == -static_cast<int>(i) - 2));
+
+        std::vector<int> or_values;
+        for (const int i : input | dze::views::values_or(42))
+            or_values.push_back(i);
+        REQUIRE(or_values.size() == size);
+        for (size_t i = 0; i != size; ++i)
+            REQUIRE(or_values[i] == input[i].value_or(42));
+    }
+}
+
+TEST_CASE("Engaged view over non-contiguous ranges", "[views.engaged]")
+{
+    const std::forward_list<dze::optional<std::string>> input = {"a", {}, "b", {}, {}, "c"};
+
+    std::string joined;
+    for (const auto& [i, str] : input | dze::views::enumerate_engaged)
+        joined += std::to_string(i) + str;
+    REQUIRE(joined == "0a2b5c");
+}
+
+TEST_CASE("Engaged view over optional references", "[views.engaged]")
+{
+    int a = 1;
+    int b = 2;
+    const std::vector<dze::optional_reference<int>> input = {a, {}, b, {}};
+
+    for (int& i : input | dze::views::engaged)
+        i *= 10;
+    REQUIRE(a == 10);
+    REQUIRE(b == 20);
+
+    std::vector<int> values;
+    for (const int i : input | dze::views::values_or(0))
+        values.push_back(i);
+    REQUIRE(values == std::vector<int>{10, 0, 20, 0});
+}
+
+TEST_CASE("Engaged view over temporaries", "[views.engaged]")
+{
+    int sum = 0;
+    for (const int i : make_input<dze::optional<int>>(10) | dze::views::engaged)
+        sum += i;
+    REQUIRE(sum == 1 + 2 + 4 + 5 + 7 + 8);
+}
+
+#ifdef __cpp_lib_ranges
+TEST_CASE("Engaged view composition", "[views.engaged]")
+{
+    auto input = make_input<dze::sentinel<int, -1>>(100);
+
+    STATIC_REQUIRE(std::ranges::view<decltype(input | dze::views::engaged)>);
+    STATIC_REQUIRE(std::ranges::forward_range<decltype(input | dze::views::engaged)>);
+
+    std::vector<int> values;
+    for (const int i :
+        input | std::views::take(10) | dze::views::engaged | std::views::transform([](int i) {
+            return i * 2;
+        }))
+        values.push_back(i);
+    REQUIRE(values == std::vector<int>{2, 4, 8, 10, 14, 16});
+}
+#endif
+
+TEST_CASE("Const views", "[views.engaged]")
+{
+    const auto input = make_input<dze::sentinel<int, -1>>(100);
+    std::forward_list<dze::optional<int>> list{1, {}, 2};
+
+    const auto engaged = input | dze::views::engaged;
+    const auto enumerated = list | dze::views::enumerate_engaged;
+    const auto values =
+        std::forward_list<dze::optional<int>>{1, {}, 2} | dze::views::values_or(0);
+
+    int expected = 0;
+    for (const auto& opt : input)
+        expected += opt.value_or(0);
+
+    int sum = 0;
+    for (const int i : engaged)
+        sum += i;
+    REQUIRE(sum == expected);
+
+    size_t index_sum = 0;
+    for (const auto [i, value] : enumerated)
+        index_sum += i;
+    REQUIRE(index_sum == 2);
+
+    std::vector<int> all;
+    for (const int i : values)
+        all.push_back(i);
+    REQUIRE(all == std::vector<int>{1, 0, 2});
+
+    using enumerate_iterator = decltype(enumerated.begin());
+    using values_iterator = decltype(values.begin());
+    STATIC_REQUIRE(std::is_same_v<
+        std::iterator_traits<decltype(engaged.begin())>::iterator_category,
+        std::forward_iterator_tag>);
+    STATIC_REQUIRE(std::is_same_v<
+        std::iterator_traits<enumerate_iterator>::iterator_category,
+        std::input_iterator_tag>);
+    STATIC_REQUIRE(std::is_same_v<
+        std::iterator_traits<values_iterator>::iterator_category,
+        std::input_iterator_tag>);
+#ifdef __cpp_lib_ranges
+    STATIC_REQUIRE(std::forward_iterator<enumerate_iterator>);
+    STATIC_REQUIRE(std::forward_iterator<values_iterator>);
+#endif
+}